@@ -10,7 +10,7 @@
 
 namespace hr {
 
-ld eyepos;
+EX ld eyepos;
 
 #if MAXMDIM >= 4
 
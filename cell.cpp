@@ -101,6 +101,28 @@ public:
   virtual struct backed_map* get_backmap() { return nullptr; }
   };
 
+/** \brief an index of the move(0) ancestors of heptagons, used by hrmap_standard::relative_matrixh
+ *
+ *  Every indexed heptagon has a single jump pointer (skew-binary jumps, as in Myers' random access lists),
+ *  so that any ancestor is reached in O(log d) jumps, together with the matrices composed along that jump.
+ *  Heptagons are indexed lazily. The index is dropped whenever heptagons are deleted (see ancestor_generation).
+ */
+struct ancestor_index {
+  struct entry {
+    /** the ancestor we jump to, or nullptr for the root */
+    heptagon *jump;
+    /** the number of move(0) steps to the root */
+    int depth;
+    /** the product of adj(h, 0) along the jump, and the product of iadj(h, 0) in the reverse order */
+    transmatrix T, iT;
+    };
+  std::unordered_map<heptagon*, entry> data;
+  int generation = -1;
+  /** the largest difference of distances between a heptagon and its parent seen so far */
+  int max_drop = 1;
+  entry& get(hrmap *m, heptagon *h);
+  };
+
 /** hrmaps which are based on regular non-Euclidean 2D tilings, possibly quotient  
  *  Operators can be applied to these maps. 
  *  Liskov substitution warning: maps which produce both tiling like above and 3D tilings
@@ -122,6 +144,7 @@ struct hrmap_standard : hrmap, dim_listener {
   bool link_alt(heptagon *h, heptagon *alt, hstate firststate, int dir) override;
   void on_dim_change() override;
   int pattern_value(cell *c) override;
+  ancestor_index ancestors;
   };
 
 void clearfrom(heptagon*);
@@ -397,8 +420,8 @@ EX void init_disk_cells() {
   all_disk_cells_sorted.clear();
   if(!disksize) return;
   if(diskshape == dshTiles) {
-    celllister cl(currentmap->gamestart(), 1000000, disksize, NULL);
-    all_disk_cells = cl.lst;
+    bfs_lister bl;
+    bl.stream(currentmap->gamestart(), 1000000, disksize, [] (cell *c, int d) { all_disk_cells.push_back(c); return true; });
     }
   else {
     struct tileinfo {
@@ -698,12 +721,14 @@ void unlink_cdata(heptagon *h) {
   }
 
 EX void clear_heptagon(heptagon *at) {
+  ancestor_generation++;
   clearHexes(at);
   tailored_delete(at);
   }
 
 EX void clearfrom(heptagon *at) {
   if(!at) return;
+  ancestor_generation++;
   queue<heptagon*> q;
   unlink_cdata(at);
   q.push(at);
@@ -1392,12 +1417,32 @@ set<cell*> dists_computed;
 
 int perma_distances;
 
-EX void compute_saved_distances(cell *c1, int max_range, int climit) {
-    
-  celllister cl(c1, max_range, climit, NULL);
+/** \brief can the whole current map be traversed without generating anything?
+ *
+ *  Only closed manifolds which are not huge can be; the first call for such a map generates all of it.
+ */
+hrmap *fully_generated_map;
+int fully_generated_cellcount;
+
+EX bool map_fully_generated() {
+  if(!closed_manifold || (cgflags & qHUGE_BOUNDED) || mhybrid || disksize) return false;
+  if(fully_generated_map == currentmap && fully_generated_cellcount == cellcount) return true;
+  int before = cellcount;
+  for(cell *c: currentmap->allcells()) for(int i=0; i<c->type; i++) c->cmove(i);
+  /* if new cells appeared, allcells() did not list the whole map */
+  if(cellcount != before) return false;
+  fully_generated_map = currentmap; fully_generated_cellcount = cellcount;
+  return true;
+  }
 
-  for(int i=0; i<isize(cl.lst); i++)
-    saved_distances[make_pair(c1, cl.lst[i])] = cl.dists[i];
+auto fully_generated_hook = addHook(hooks_clearmemory, 0, [] { fully_generated_map = nullptr; });
+
+EX void compute_saved_distances(cell *c1, int max_range, int climit) {
+  /* a local lister, since generating the cells may lead to a recursive call;
+   * on a fully generated map, nothing needs to be generated, and large frontiers
+   * can be expanded in parallel */
+  bfs_lister bl(!map_fully_generated());
+  bl.stream(c1, max_range, climit, [c1] (cell *c, int d) { saved_distances[make_pair(c1, c)] = d; return true; });
   }
 
 EX void permanent_long_distances(cell *c1) {
@@ -1429,6 +1474,240 @@ EX cell *random_in_distance(cell *c, int d) {
   return choices[hrand(isize(choices))];
   }
 
+/** \brief distances on closed manifolds, computed on the adjacency graph of all cells
+ *
+ *  If the map is frame-transitive (the combinatorial automorphisms act transitively on
+ *  cellwalkers, as in the regular quotients), a single row of distances from gamestart()
+ *  is enough: to compute d(c1,c2), we walk the path leading to c2 from the frame which is
+ *  the image of the origin frame under the automorphism taking c1 to gamestart().
+ *  Otherwise we keep rows of distances from each queried source, packed into one or two
+ *  bytes per cell, and drop them all when distance_oracle_budget is exceeded. The rows are
+ *  computed lazily, so (like the rest of celldistance) this mode is main-thread only.
+ */
+
+EX bool distance_oracle_enabled = true;
+
+/** memory budget (in MB) for the per-source rows of distance_oracle */
+EX int distance_oracle_budget = 256;
+
+struct distance_oracle {
+
+  /** a cellwalker on the adjacency graph */
+  struct frame {
+    int id;
+    int spin;
+    bool mirrored;
+    bool operator == (const frame& f) const { return id == f.id && spin == f.spin && mirrored == f.mirrored; }
+    };
+
+  enum eState { osEmpty, osBuilding, osUnusable, osRows, osSymmetric };
+  eState state = osEmpty;
+  hrmap *for_map = nullptr;
+
+  vector<cell*> cells;
+  std::unordered_map<cell*, int> id;
+  int maxdeg;
+  vector<int> type, adj_to, adj_spin;
+  vector<char> adj_mirror;
+
+  /** bytes per distance */
+  int width;
+  int unknown;
+  vector<vector<unsigned char>> rows;
+  vector<unsigned char> row0;
+  size_t row_bytes;
+
+  /** BFS tree from the origin frame: frame of x is the frame of parent[x], rotated by rot[x] and stepped */
+  vector<int> parent, rot, order;
+  /** inv[x] is the origin frame walked along the inverse of the path to x */
+  vector<frame> inv;
+
+  frame rotate(frame f, int i) {
+    f.spin = gmod(f.spin + (f.mirrored ? -i : i), type[f.id]);
+    return f;
+    }
+
+  frame step(frame f) {
+    int e = f.id * maxdeg + f.spin;
+    if(adj_mirror[e]) f.mirrored = !f.mirrored;
+    f.id = adj_to[e]; f.spin = adj_spin[e];
+    return f;
+    }
+
+  void reset() {
+    state = osEmpty; for_map = nullptr;
+    cells.clear(); id.clear(); type.clear(); adj_to.clear(); adj_spin.clear(); adj_mirror.clear();
+    rows.clear(); row0.clear(); row_bytes = 0;
+    parent.clear(); rot.clear(); order.clear(); inv.clear();
+    }
+
+  vector<unsigned char> compute_row(int src) {
+    int N = isize(cells);
+    vector<int> dist(N, -1), queue;
+    queue.reserve(N);
+    dist[src] = 0; queue.push_back(src);
+    for(int qi=0; qi<isize(queue); qi++) {
+      int x = queue[qi];
+      for(int i=0; i<type[x]; i++) {
+        int y = adj_to[x * maxdeg + i];
+        if(dist[y] == -1) dist[y] = dist[x] + 1, queue.push_back(y);
+        }
+      }
+    vector<unsigned char> row(N * width);
+    for(int i=0; i<N; i++) {
+      int d = dist[i] == -1 ? unknown : dist[i];
+      if(width == 1) row[i] = d;
+      else row[2*i] = d & 255, row[2*i+1] = d >> 8;
+      }
+    return row;
+    }
+
+  int read(const vector<unsigned char>& row, int i) {
+    int d = width == 1 ? row[i] : (row[2*i] | (row[2*i+1] << 8));
+    return d == unknown ? DISTANCE_UNKNOWN : d;
+    }
+
+  /** check whether the map taking the origin frame to g extends to an automorphism */
+  bool is_automorphism(frame g) {
+    int N = isize(cells);
+    vector<frame> F(N), G(N);
+    vector<char> hit(N, false);
+    F[0] = frame{0, 0, false}; G[0] = g;
+    for(int x: order) if(x) {
+      F[x] = step(rotate(F[parent[x]], rot[x]));
+      G[x] = step(rotate(G[parent[x]], rot[x]));
+      }
+    for(int x=0; x<N; x++) {
+      if(type[G[x].id] != type[x] || hit[G[x].id]) return false;
+      hit[G[x].id] = true;
+      }
+    for(int x=0; x<N; x++) for(int i=0; i<type[x]; i++) {
+      frame f1 = step(rotate(F[x], i));
+      frame g1 = step(rotate(G[x], i));
+      const frame& fy = F[f1.id];
+      /* f1 is fy transformed by (m, j); apply the same transformation to G[y] */
+      bool m = f1.mirrored != fy.mirrored;
+      int j = (f1.spin - fy.spin) * (f1.mirrored ? -1 : 1);
+      frame g2 = G[f1.id];
+      if(m) g2.mirrored = !g2.mirrored;
+      if(!(rotate(g2, j) == g1)) return false;
+      }
+    return true;
+    }
+
+  void build() {
+    reset();
+    state = osBuilding;
+    for_map = currentmap;
+    cells = currentmap->allcells();
+    int N = isize(cells);
+    for(int i=0; i<N; i++) id[cells[i]] = i;
+    maxdeg = 0;
+    for(cell *c: cells) maxdeg = max<int>(maxdeg, c->type);
+    type.resize(N); adj_to.resize(N * maxdeg, 0); adj_spin.resize(N * maxdeg, 0); adj_mirror.resize(N * maxdeg, false);
+    for(int x=0; x<N; x++) {
+      cell *c = cells[x];
+      type[x] = c->type;
+      for(int i=0; i<c->type; i++) {
+        cell *c1 = c->cmove(i);
+        if(!id.count(c1)) { state = osUnusable; return; }
+        adj_to[x * maxdeg + i] = id[c1];
+        adj_spin[x * maxdeg + i] = c->c.spin(i);
+        adj_mirror[x * maxdeg + i] = c->c.mirror(i);
+        }
+      }
+
+    /* the BFS tree of frames */
+    parent.resize(N, -1); rot.resize(N, 0);
+    vector<frame> F(N);
+    vector<int> dist(N, -1);
+    F[0] = frame{0, 0, false}; dist[0] = 0; order.push_back(0);
+    for(int qi=0; qi<isize(order); qi++) {
+      int x = order[qi];
+      for(int i=0; i<type[x]; i++) {
+        frame f1 = step(rotate(F[x], i));
+        if(dist[f1.id] != -1) continue;
+        dist[f1.id] = dist[x] + 1; parent[f1.id] = x; rot[f1.id] = i; F[f1.id] = f1;
+        order.push_back(f1.id);
+        }
+      }
+    if(isize(order) != N) { state = osUnusable; return; }
+
+    int ecc = dist[order.back()];
+    width = 2 * ecc < 254 ? 1 : 2;
+    unknown = width == 1 ? 255 : 65535;
+    if(width == 2 && 2 * ecc >= 65534) { state = osUnusable; return; }
+    rows.resize(N); row_bytes = 0;
+
+    frame f0 = frame{0, 0, false};
+    if(is_automorphism(rotate(f0, 1)) && is_automorphism(step(f0))) {
+      inv.resize(N);
+      for(int x=0; x<N; x++) {
+        frame h = f0;
+        for(int y=x; y; y=parent[y]) h = rotate(step(h), -rot[y]);
+        inv[x] = h;
+        }
+      row0 = compute_row(0);
+      state = osSymmetric;
+      }
+    else
+      state = osRows;
+    }
+
+  bool prepare() {
+    if(!distance_oracle_enabled) return false;
+    if(state == osBuilding) return false;
+    if(for_map != currentmap || state == osEmpty) {
+      if(!closed_manifold || (cgflags & qHUGE_BOUNDED) || mhybrid || disksize) return false;
+      build();
+      }
+    return state == osRows || state == osSymmetric;
+    }
+
+  /** in the symmetric mode, get only reads the tables; in the rows mode it fills and evicts rows, so it must only be called from the main thread */
+  int get(cell *c1, cell *c2) {
+    auto it1 = id.find(c1), it2 = id.find(c2);
+    if(it1 == id.end() || it2 == id.end()) return DISTANCE_UNKNOWN;
+    int i1 = it1->second, i2 = it2->second;
+    if(state == osSymmetric) {
+      thread_local vector<int> path;
+      path.clear();
+      for(int y=i2; y; y=parent[y]) path.push_back(y);
+      frame h = inv[i1];
+      for(int k=isize(path)-1; k>=0; k--) h = step(rotate(h, rot[path[k]]));
+      return read(row0, h.id);
+      }
+    auto& row = rows[i1];
+    if(row.empty()) {
+      if(row_bytes + cells.size() * width > (size_t(distance_oracle_budget) << 20)) {
+        for(auto& r: rows) vector<unsigned char>().swap(r);
+        row_bytes = 0;
+        }
+      row = compute_row(i1);
+      row_bytes += row.size();
+      }
+    return read(row, i2);
+    }
+
+  string mode() {
+    switch(state) {
+      case osSymmetric: return "symmetric";
+      case osRows: return "rows";
+      case osUnusable: return "unusable";
+      default: return "none";
+      }
+    }
+
+  size_t memory() {
+    size_t total = row_bytes + row0.size();
+    total += cells.size() * (sizeof(cell*) + 2 * sizeof(int) + sizeof(frame));
+    total += adj_to.size() * (2 * sizeof(int) + 1);
+    return total;
+    }
+  };
+
+distance_oracle dist_oracle;
+
 EX int bounded_celldistance(cell *c1, cell *c2) {
   int limit = 14400;
   #if CAP_SOLV
@@ -1439,12 +1718,15 @@ EX int bounded_celldistance(cell *c1, cell *c2) {
     }
   #endif
 
+  if(dist_oracle.prepare()) {
+    int d = dist_oracle.get(c1, c2);
+    if(d != DISTANCE_UNKNOWN) return d;
+    }
+
   if(saved_distances.count(make_pair(c1,c2)))
     return saved_distances[make_pair(c1,c2)];
 
-  celllister cl(c1, 100, limit, NULL);
-  for(int i=0; i<isize(cl.lst); i++)
-    saved_distances[make_pair(c1, cl.lst[i])] = cl.dists[i];
+  compute_saved_distances(c1, 100, limit);
 
   if(saved_distances.count(make_pair(c1,c2)))
     return saved_distances[make_pair(c1,c2)];
@@ -1524,6 +1806,34 @@ EX int celldistance(cell *c1, cell *c2) {
   return hyperbolic_celldistance(c1, c2);
   }
 
+/** \brief measure the speed of celldistance on all pairs of cells (at most qty queries), with and without distance_oracle */
+EX void distance_benchmark(int qty) {
+  auto ac = currentmap->allcells();
+  int N = isize(ac);
+  bool b = distance_oracle_enabled;
+  for(int enabled: {0, 1}) {
+    distance_oracle_enabled = enabled;
+    dist_oracle.reset();
+    saved_distances.clear(); dists_computed.clear();
+    erase_saved_distances();
+    long long total = 0;
+    int q = 0;
+    int t0 = SDL_GetTicks();
+    for(int i=0; i<N && q<qty; i++)
+    for(int j=0; j<N && q<qty; j++, q++)
+      total += celldistance(ac[i], ac[j]);
+    int t1 = SDL_GetTicks();
+    println(hlog, "distance benchmark: oracle ", enabled ? "on" : "off", ", mode ", enabled ? dist_oracle.mode() : "map", ": ", q, " queries in ", t1-t0, " ms, ",
+      hr::format("%.0f", q * 1000. / max(t1-t0, 1)), " queries/s, checksum ", hr::format("%lld", total),
+      enabled ? hr::format(", memory %.1f MB", dist_oracle.memory() / 1048576.) : "");
+    }
+  distance_oracle_enabled = b;
+  }
+
+auto ah_distance = arg::add3("-dist-bench", [] { arg::shift(); distance_benchmark(arg::argi()); })
+  + arg::add3("-dist-oracle", [] { arg::shift(); distance_oracle_enabled = arg::argi(); dist_oracle.reset(); })
+  + arg::add3("-dist-oracle-mb", [] { arg::shift(); distance_oracle_budget = arg::argi(); });
+
 EX vector<cell*> build_shortest_path(cell *c1, cell *c2) {
   #if CAP_CRYSTAL
   if(cryst) return crystal::build_shortest_path(c1, c2);
@@ -1581,6 +1891,7 @@ EX void clearCellMemory() {
   #if CAP_PORTALS
   if(intra::in) {
     intra::erase_all_maps();
+    tailored_memory.release_if_unused();
     return;
     }
   #endif
@@ -1592,9 +1903,11 @@ EX void clearCellMemory() {
   last_cleared = NULL;
   saved_distances.clear();
   dists_computed.clear();
+  dist_oracle.reset();
   keep_distances_from.clear(); perma_distances = 0;
   pd_from = NULL;
   gp::gp_adj.clear();
+  tailored_memory.release_if_unused();
   }
 
 auto cellhooks = addHook(hooks_clearmemory, 500, clearCellMemory);
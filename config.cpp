@@ -1565,6 +1565,7 @@ EX void initConfig() {
   param_i(rug::texturesize, "rug-texturesize");
 #if CAP_RUG
   param_f(rug::model_distance, "rug-model-distance");
+  param_i(rug::sweep_min_points, "rug-sweep-min-points");
 #endif
 
   param_b(vid.backeffects, "background particle effects", (ISMOBILE || ISPANDORA) ? false : true)
@@ -1721,6 +1722,7 @@ EX void initConfig() {
   param_b(vid.smart_area_based, "smart-area-based", false);
   param_i(vid.cells_drawn_limit, "limit on cells drawn", 10000);
   param_i(vid.cells_generated_limit, "limit on cells generated", 250);
+  param_i(worker_threads, "worker_threads", 1);
 
   param_enum(diskshape, "disk_shape", dshTiles)
     ->editable({{"distance in tiles", ""}, {"distance in vertices", ""}, {"geometric distance", ""}
@@ -2176,7 +2178,7 @@ EX void loadConfig() {
 #endif
 
 EX void add_cells_drawn(char c IS('C')) {
-  dialog::addSelItem(XLAT("cells drawn"), (noclipped ? its(cells_drawn) + " (" + its(noclipped) + ")" : its(cells_drawn)) + " / " + its(vid.cells_drawn_limit), c);
+  dialog::addSelItem(XLAT("cells drawn"), (noclipped ? its(cells_drawn) + " (" + its(noclipped) + ")" : its(cells_drawn)) + " / " + its(vid.cells_drawn_limit) + ", " + fts(draw_all_ms, 3) + " ms", c);
   dialog::add_action([] () { 
     dialog::editNumber(vid.cells_drawn_limit, 100, 1000000, log(10), 10000, XLAT("limit on cells drawn"), 
       XLAT("This limit exists to protect the engine from freezing when too many cells would be drawn according to the current options.")
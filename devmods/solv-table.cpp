@@ -155,15 +155,12 @@ void write_table(sn::tabled_inverses& tab, const char *fname) {
   fint(f, tab.PRECX);
   fint(f, tab.PRECY);
   fint(f, tab.PRECZ);
-  fwrite(&tab.tab[0], sizeof(ptlow) * tab.PRECX * tab.PRECY * tab.PRECZ, 1, f);
+  fwrite(&tab.get_int(0, 0, 0), sizeof(ptlow) * tab.PRECX * tab.PRECY * tab.PRECZ, 1, f);
   fclose(f);
   }
 
 void alloc_table(sn::tabled_inverses& tab, int X, int Y, int Z) {
-  tab.PRECX = X;
-  tab.PRECY = Y;
-  tab.PRECZ = Z;
-  tab.tab.resize(X*Y*Z);
+  tab.resize(X, Y, Z);
   }
 
 ld ptd(ptlow p) {
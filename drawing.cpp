@@ -42,6 +42,8 @@ static constexpr flagtype POLY_APEIROGONAL = Flag(29);    // only vertices index
 static constexpr flagtype POLY_NO_FOG = Flag(30);         // disable fog for this
 static constexpr flagtype POLY_FORCE_DEPTH = Flag(31);    // always depth test
 
+extern tailored_pool drawqueue_memory;
+
 /** \brief A graphical element that can be drawn. Objects are not drawn immediately but rather queued.
  *
  *  HyperRogue map rendering functions do not draw its data immediately; instead, they call the 'queue' functions
@@ -49,6 +51,9 @@ static constexpr flagtype POLY_FORCE_DEPTH = Flag(31);    // always depth test
  */
 
 struct drawqueueitem {
+  /** \brief drawqueueitems are recycled through drawqueue_memory, so that steady-state frames do not use the heap */
+  static void* operator new(size_t sz) { return drawqueue_memory.alloc(sz); }
+  static void operator delete(void *p, size_t sz) { drawqueue_memory.dealloc(p, sz); }
   /** \brief The higher the priority, the earlier we should draw this object. */
   PPR prio;
   /** \brief Color of this object. */
@@ -165,6 +170,8 @@ EX color_t poly_outline;
 
 EX vector<unique_ptr<drawqueueitem>> ptds;
 
+tailored_pool drawqueue_memory;
+
 #if CAP_GL
 EX color_t text_color;
 EX int text_shift;
@@ -501,16 +508,20 @@ bool behind3(shiftpoint h) {
   return h[2] < 0;
   }
 
+/** the points of the polygon being added, already transformed */
+vector<hyperpoint> polypoints;
+
 void addpoly(const shiftmatrix& V, const vector<glvertex> &tab, int ofs, int cnt) {
+  polypoints.resize(cnt);
+  for(int i=0; i<cnt; i++) polypoints[i] = glhr::gltopoint(tab[ofs+i]);
+  #if MAXMDIM >= 4
+  if(pmodel == mdPixel) for(auto& h: polypoints) h[3] = 1;
+  #endif
+  apply_batch(V.T, polypoints);
+  auto pt = [&] (int i) { return shiftpoint{polypoints[i-ofs], V.shift}; };
+
   if(pmodel == mdPixel) {
-    for(int i=ofs; i<ofs+cnt; i++) {
-      hyperpoint h = glhr::gltopoint(tab[i]);
-      #if MAXMDIM >= 4
-      h[3] = 1;
-      #endif
-      h = V.T * h;
-      add1(h);
-      }
+    for(auto& h: polypoints) add1(h);
     return;
     }
   tofix.clear(); knowgood = false;
@@ -519,35 +530,35 @@ void addpoly(const shiftmatrix& V, const vector<glvertex> &tab, int ofs, int cnt
       dynamicval<bool> d(computing_semidirect, true);
       for(int i=ofs; i<ofs+cnt; i++) {
         hyperpoint Hscr;
-        applymodel(V * glhr::gltopoint(tab[i]), Hscr);
+        applymodel(pt(i), Hscr);
         add1(Hscr);
         }
       }
     else if(poly_flags & POLY_TRIANGLES) {
       for(int i=ofs; i<ofs+cnt; i+=3) {
-        shiftpoint h0 = V * glhr::gltopoint(tab[i]);
-        shiftpoint h1 = V * glhr::gltopoint(tab[i+1]);
-        shiftpoint h2 = V * glhr::gltopoint(tab[i+2]);
+        shiftpoint h0 = pt(i);
+        shiftpoint h1 = pt(i+1);
+        shiftpoint h2 = pt(i+2);
         if(!behind3(h0) && !behind3(h1) && !behind3(h2)) 
           addpoint(h0), addpoint(h1), addpoint(h2);
         }
       }
     else {
       for(int i=ofs; i<ofs+cnt; i++) {
-        shiftpoint h = V * glhr::gltopoint(tab[i]);
+        shiftpoint h = pt(i);
         if(!behind3(h)) addpoint(h);
         }
       }
     return;
     }
-  shiftpoint last = V * glhr::gltopoint(tab[ofs]);
+  shiftpoint last = pt(ofs);
   bool last_behind = is_behind(last.h);
   if(!last_behind) addpoint(last);
   hyperpoint enter = C0;
   hyperpoint firstleave;
   int start_behind = last_behind ? 1 : 0;
   for(int i=ofs+1; i<ofs+cnt; i++) {
-    shiftpoint curr = V*glhr::gltopoint(tab[i]);
+    shiftpoint curr = pt(i);
     if(is_behind(curr.h) != last_behind) {
       hyperpoint h = be_just_on_view(last.h, curr.h);
       if(start_behind == 1) start_behind = 2, firstleave = h;
@@ -2350,32 +2361,56 @@ void dqi_line::draw_back() {
   draw();
   }
 
+/* sort_drawqueue keys; the buffers are kept between frames, so that sorting does not allocate */
+struct dqsort_entry { color_t color, group; int prio, id; };
+vector<dqsort_entry> dqsort_a, dqsort_b;
+vector<unique_ptr<drawqueueitem>> ptds_sorted;
+
+/** a stable counting sort pass of dqsort_a by the given 8-bit digit */
+template<class T> void dqsort_pass(const T& digit) {
+  int siz = isize(dqsort_a);
+  if(!siz) return;
+  int cnt[256];
+  for(int i=0; i<256; i++) cnt[i] = 0;
+  for(auto& e: dqsort_a) cnt[digit(e)]++;
+  if(cnt[digit(dqsort_a[0])] == siz) return;
+  int total = 0;
+  for(int i=0; i<256; i++) { int b = cnt[i]; cnt[i] = total; total += b; }
+  dqsort_b.resize(siz);
+  for(auto& e: dqsort_a) dqsort_b[cnt[digit(e)]++] = e;
+  swap(dqsort_a, dqsort_b);
+  }
+
+/** sort ptds by (prio, color, outline group), stably; circles are not grouped by color */
 EX void sort_drawqueue() {
   DEBBI(debug_graph, ("sort_drawqueue"));
   
   for(int a=0; a<PMAX; a++) qp[a] = 0;
   
   int siz = isize(ptds);
+  dqsort_a.resize(siz);
 
-  #if MINIMIZE_GL_CALLS
-  map<color_t, vector<unique_ptr<drawqueueitem>>> subqueue;
-  for(auto& p: ptds) subqueue[(p->prio == PPR::CIRCLE || p->prio == PPR::OUTCIRCLE) ? 0 : p->outline_group()].push_back(std::move(p));
-  ptds.clear();
-  for(auto& p: subqueue) for(auto& r: p.second) ptds.push_back(std::move(r));
-  subqueue.clear();
-  for(auto& p: ptds) subqueue[(p->prio == PPR::CIRCLE || p->prio == PPR::OUTCIRCLE) ? 0 : p->color].push_back(std::move(p));
-  ptds.clear();
-  for(auto& p: subqueue) for(auto& r: p.second) ptds.push_back(std::move(r));
-  #endif
-    
-  for(auto& p: ptds) {
+  for(int i=0; i<siz; i++) {
+    auto& p = ptds[i];
     int pd = p->prio - PPR::ZERO;
     if(pd < 0 || pd >= PMAX) {
       printf("Illegal priority %d\n", pd);
       p->prio = PPR(rand() % int(PPR::MAX));
+      pd = p->prio - PPR::ZERO;
       }
     qp[pd]++;
+    auto& e = dqsort_a[i];
+    e.id = i; e.prio = pd; e.color = e.group = 0;
+    #if MINIMIZE_GL_CALLS
+    if(p->prio != PPR::CIRCLE && p->prio != PPR::OUTCIRCLE)
+      e.group = p->outline_group(), e.color = p->color;
+    #endif
     }
+
+  #if MINIMIZE_GL_CALLS
+  for(int b=0; b<32; b+=8) dqsort_pass([b] (const dqsort_entry& e) { return (e.group >> b) & 255; });
+  for(int b=0; b<32; b+=8) dqsort_pass([b] (const dqsort_entry& e) { return (e.color >> b) & 255; });
+  #endif
   
   int total = 0;
   for(int a=0; a<PMAX; a++) {
@@ -2383,11 +2418,10 @@ EX void sort_drawqueue() {
     qp0[a] = qp[a] = total; total += b;
     }
 
-  vector<unique_ptr<drawqueueitem>> ptds2;  
-  ptds2.resize(siz);
-  
-  for(int i = 0; i<siz; i++) ptds2[qp[int(ptds[i]->prio)]++] = std::move(ptds[i]);
-  swap(ptds, ptds2);
+  ptds_sorted.resize(siz);
+  for(auto& e: dqsort_a) ptds_sorted[qp[e.prio]++] = std::move(ptds[e.id]);
+  swap(ptds, ptds_sorted);
+  ptds_sorted.clear();
   }
 
 EX void reverse_priority(PPR p) {
@@ -350,22 +350,42 @@ struct fpattern {
   };
 
 #if CAP_THREAD && MAXMDIM >= 4
+/** background search for the field quotients of a 3D tiling, split into jobs run by several threads */
 struct discovery {
-  fpattern experiment;
-  std::shared_ptr<std::thread> discoverer;
+  /** a single job: a field of size prime (wsquare == 0) or prime^2 */
+  struct job {
+    int prime, wsquare;
+    /** 0 = waiting, 1 = running, 2 = done */
+    int state;
+    };
+
+  string name;
+  vector<job> jobs;
+  vector<std::thread> workers;
   std::mutex lock;
   std::condition_variable cv;
   bool is_suspended;
-  bool stop_it;
+  std::atomic<bool> stop_it;
+  bool cache_loaded;
   
+  /** thrown by check_suspend when the discovery is cancelled, to abort fpattern::solve3 at once */
+  struct cancelled {};
+
   map<unsigned, tuple<int, int, matrix, matrix, matrix, int> > hashes_found;
-  discovery() : experiment(0) { is_suspended = false; stop_it = false; experiment.dis = this; experiment.Prime = experiment.Field = experiment.wsquare = 0; }
+  discovery() { is_suspended = false; stop_it = false; cache_loaded = false; }
   
+  bool running() { return !workers.empty(); }
+  bool finished();
+  void create_jobs();
   void activate();
   void suspend();
+  void cancel();
   void check_suspend();
-  void schedule_destruction();
-  void discovered();
+  void work();
+  void discovered(fpattern& e);
+  string cache_file();
+  void load_cache();
+  void save_cache();
   ~discovery();
   };
 #endif
@@ -439,7 +459,6 @@ vector<matrix> fpattern::generate_isometries3() {
   if(colprod(1, 0) == 0) {
     #if CAP_THREAD && MAXMDIM >= 4
     if(dis) dis->check_suspend();
-    if(dis && dis->stop_it) return res;
     #endif
 
     for(T[0][2]=low; T[0][2]<Prime; T[0][2]++)
@@ -524,6 +543,9 @@ bool fpattern::generate_all3() {
   if(local_group != isize(cgi.cellrotations)) return false;
 
   for(int i=0; i<(int)matrices.size(); i++) {
+    #if CAP_THREAD && MAXMDIM >= 4
+    if(dis && (i & 1023) == 0) dis->check_suspend();
+    #endif
     matrix E = mmul(matrices[i], P);
     if(!matcode.count(E))
       for(int j=0; j<local_group; j++) add1(mmul(E, matrices[j]));
@@ -531,8 +553,14 @@ bool fpattern::generate_all3() {
     if(isize(matrices) >= limitv) { println(hlog, "limitv exceeded"); return false; }
     }
   hashv = compute_hash();
-  if(debug_field)
+  if(debug_field) {
+    #if CAP_THREAD
+    /* discovery calls this from several threads */
+    static std::mutex debug_lock;
+    std::unique_lock<std::mutex> lk(debug_lock);
+    #endif
     println(hlog, "all = ", isize(matrices), "/", local_group, " = ", isize(matrices) / local_group, " hash = ", hashv, " count = ", ++hash_found[hashv]);
+    }
   
   if(use_quotient_fp) 
     generate_quotientgroup();  
@@ -643,14 +671,13 @@ int fpattern::solve3() {
 
     #if CAP_THREAD && MAXMDIM >= 4
     if(dis) dis->check_suspend();
-    if(dis && dis->stop_it) return 0;
     #endif
 
     P = xP; R = xR; X = xX;
     if(!generate_all3()) continue;
     callhooks(hooks_solve3);
     #if CAP_THREAD && MAXMDIM >= 4
-    if(dis) { dis->discovered(); continue; }
+    if(dis) { dis->discovered(*this); continue; }
     #endif
     if(force_hash && hashv != force_hash) continue;
     cmb++;
@@ -1539,50 +1566,208 @@ EX void field_from_current() {
   }
 
 #if CAP_THREAD && MAXMDIM >= 4
+/** discoveries, indexed by tiling name */
 EX map<string, discovery> discoveries;
 
+/** the number of threads used by a discovery; 0 = one per core */
+EX int discovery_threads = 0;
+
+/** should the discovered quotients be saved in user_cache_dir() */
+EX bool discovery_cache = true;
+
+/** the same jobs as the loop in fpattern::solve does for 3D tilings */
+void discovery::create_jobs() {
+  jobs.clear();
+  for(int p=2; p<100; p++) if(isprime(p)) {
+    jobs.push_back(job{p, 0, 0});
+    if(p > limitsq) continue;
+    int wsquare;
+    for(wsquare=1; wsquare<p; wsquare++) {
+      int roots = 0;
+      for(int a=0; a<p; a++) if((a*a)%p == wsquare) roots++;
+      if(!roots) break;
+      }
+    jobs.push_back(job{p, wsquare, 0});
+    }
+  }
+
+bool discovery::finished() {
+  std::unique_lock<std::mutex> lk(lock);
+  if(jobs.empty()) return false;
+  for(auto& j: jobs) if(j.state != 2) return false;
+  return true;
+  }
+
 void discovery::activate() {
-  if(!discoverer) {
-    discoverer = std::make_shared<std::thread> ( [this] {
-      for(int p=2; p<100; p++) {
-        experiment.Prime = p;
-        experiment.solve();
-        if(stop_it) break;
-        }
-      });
+  if(!running()) {
+    load_cache();
+    if(jobs.empty()) create_jobs();
+    /* compute these on the main thread, the workers only read them */
+    reg3::generate_fulls();
+    stop_it = false;
+    int qty = discovery_threads ? discovery_threads : max<int>(1, std::thread::hardware_concurrency());
+    for(int i=0; i<qty; i++) workers.emplace_back([this] { work(); });
     }
   if(is_suspended) {
     if(1) {
       std::unique_lock<std::mutex> lk(lock);
       is_suspended = false;
       }
-    cv.notify_one();
+    cv.notify_all();
     }
   }
 
-void discovery::discovered() {
+void discovery::work() {
+  /* cancel() resets the state of the interrupted job */
+  try {
+    while(true) {
+      check_suspend();
+      int id = -1;
+      if(1) {
+        std::unique_lock<std::mutex> lk(lock);
+        for(int i=0; i<isize(jobs); i++) if(jobs[i].state == 0) { id = i; jobs[i].state = 1; break; }
+        }
+      if(id == -1) return;
+
+      fpattern e(0);
+      e.dis = this;
+      e.set_field(jobs[id].prime, jobs[id].wsquare);
+      e.rotations = 4;
+      e.local_group = 24;
+      e.dual = 0;
+      e.solve3();
+
+      std::unique_lock<std::mutex> lk(lock);
+      jobs[id].state = 2;
+      save_cache();
+      }
+    }
+  catch(cancelled&) {}
+  }
+
+void discovery::discovered(fpattern& e) {
   std::unique_lock<std::mutex> lk(lock);
-  auto& e = experiment;
   hashes_found[e.hashv] = make_tuple(e.Prime, e.wsquare, e.R, e.P, e.X, isize(e.matrices) / e.local_group);
   }
 
-void discovery::suspend() { is_suspended = true; }
+void discovery::suspend() {
+  std::unique_lock<std::mutex> lk(lock);
+  is_suspended = true;
+  }
 
+/** wait while the discovery is suspended; throws cancelled if it is being cancelled */
 void discovery::check_suspend() { 
   std::unique_lock<std::mutex> lk(lock);
-  if(is_suspended) cv.wait(lk, [this] { return !is_suspended; });
+  if(is_suspended) cv.wait(lk, [this] { return !is_suspended || stop_it; });
+  if(stop_it) throw cancelled();
+  }
+
+/** stop all the workers; the results found so far are kept, and the interrupted jobs are redone on the next activate() */
+void discovery::cancel() {
+  stop_it = true;
+  if(1) {
+    std::unique_lock<std::mutex> lk(lock);
+    is_suspended = false;
+    }
+  cv.notify_all();
+  for(auto& w: workers) w.join();
+  workers.clear();
+  for(auto& j: jobs) if(j.state == 1) j.state = 0;
+  stop_it = false;
+  }
+
+discovery::~discovery() { cancel(); }
+
+string discovery::cache_file() {
+  if(!discovery_cache || name == "") return "";
+  string dir = user_cache_dir();
+  if(dir == "") return "";
+  string fname = "fieldquotients-";
+  for(char c: name) fname += (isalnum(c) ? c : '_');
+  return dir + "/" + fname + ".dat";
+  }
+
+void discovery_header(hstream& f, const string& name) {
+  f.write<string>("HyperRogue field quotients");
+  for(int i: {1, MAXMDIM, limitsq, limitp, limitv}) f.write<int>(i);
+  f.write<string>(name);
   }
 
-void discovery::schedule_destruction() { stop_it = true; }
-discovery::~discovery() { schedule_destruction(); if(discoverer) discoverer->join(); }
+/** save the finished jobs and the results; called with the lock held */
+void discovery::save_cache() {
+  string fname = cache_file();
+  if(fname == "") return;
+  try {
+    fhstream f(fname + ".tmp", "wb");
+    if(!f.f) return;
+    discovery_header(f, name);
+    f.write<int>(isize(jobs));
+    for(auto& j: jobs) { f.write<int>(j.prime); f.write<int>(j.wsquare); f.write<int>(j.state == 2); }
+    f.write<int>(isize(hashes_found));
+    for(auto& h: hashes_found) {
+      f.write<unsigned>(h.first);
+      f.write<int>(get<0>(h.second));
+      f.write<int>(get<1>(h.second));
+      hwrite_raw(f, get<2>(h.second));
+      hwrite_raw(f, get<3>(h.second));
+      hwrite_raw(f, get<4>(h.second));
+      f.write<int>(get<5>(h.second));
+      }
+    }
+  catch(hstream_exception& e) { return; }
+  rename((fname + ".tmp").c_str(), fname.c_str());
+  }
+
+void discovery::load_cache() {
+  if(cache_loaded || running()) return;
+  cache_loaded = true;
+  string fname = cache_file();
+  if(fname == "" || !file_exists(fname)) return;
+  try {
+    fhstream f(fname, "rb");
+    if(!f.f) return;
+    shstream expected;
+    discovery_header(expected, name);
+    string header(isize(expected.s), 0);
+    f.read_chars(&header[0], isize(header));
+    if(header != expected.s) return;
+    vector<job> loaded_jobs(f.get<int>());
+    for(auto& j: loaded_jobs) { j.prime = f.get<int>(); j.wsquare = f.get<int>(); j.state = f.get<int>() ? 2 : 0; }
+    map<unsigned, tuple<int, int, matrix, matrix, matrix, int> > loaded;
+    int qty = f.get<int>();
+    for(int i=0; i<qty; i++) {
+      auto& h = loaded[f.get<unsigned>()];
+      get<0>(h) = f.get<int>();
+      get<1>(h) = f.get<int>();
+      hread_raw(f, get<2>(h));
+      hread_raw(f, get<3>(h));
+      hread_raw(f, get<4>(h));
+      get<5>(h) = f.get<int>();
+      }
+    std::unique_lock<std::mutex> lk(lock);
+    jobs = std::move(loaded_jobs);
+    for(auto& h: loaded) hashes_found.insert(h);
+    if(debug_field) println(hlog, "loaded ", isize(loaded), " field quotients from ", fname);
+    }
+  catch(hstream_exception& e) {
+    if(debug_field) println(hlog, "could not read ", fname);
+    }
+  }
+
+EX discovery& get_discovery(const string& name) {
+  auto& ds = discoveries[name];
+  ds.name = name;
+  ds.load_cache();
+  return ds;
+  }
 #endif
 
 int hk = 
 #if CAP_THREAD
 #if MAXMDIM >= 4
-  + addHook(hooks_on_geometry_change, 100, [] { for(auto& d:discoveries) if(!d.second.is_suspended) d.second.suspend(); })
+  + addHook(hooks_on_geometry_change, 100, [] { for(auto& d:discoveries) if(d.second.running() && !d.second.is_suspended) d.second.suspend(); })
   + addHook(hooks_final_cleanup, 100, [] { 
-      for(auto& d:discoveries) { d.second.schedule_destruction(); if(d.second.is_suspended) d.second.activate(); }
+      for(auto& d:discoveries) d.second.cancel();
       discoveries.clear();
       })
 #endif
@@ -1594,6 +1779,10 @@ int hk =
       else if(argis("-q3-limitsq")) { shift(); limitsq = argi(); }
       else if(argis("-q3-limitp")) { shift(); limitp = argi(); }
       else if(argis("-q3-limitv")) { shift(); limitv = argi(); }
+      #if CAP_THREAD && MAXMDIM >= 4
+      else if(argis("-q3-threads")) { shift(); discovery_threads = argi(); }
+      else if(argis("-q3-nocache")) { discovery_cache = false; }
+      #endif
       else return 1;
       return 0;
       })
@@ -474,14 +474,14 @@ EX void showQuotientConfig3() {
   gamescreen();
   dialog::init(XLAT("field quotient"));
   
-  auto& ds = discoveries[cginf.tiling_name];
+  auto& ds = get_discovery(cginf.tiling_name);
+  bool finished = ds.finished();
   
-  if(!ds.discoverer) {
-    dialog::addItem("start discovery", 's');
-    dialog::add_action([&ds] { ds.activate(); });
+  if(finished) {
+    dialog::addInfo(XLAT("discovery finished"));
     }
-  else if(ds.is_suspended) {
-    dialog::addItem("resume discovery", 's');
+  else if(!ds.running() || ds.is_suspended) {
+    dialog::addItem(ds.jobs.empty() ? "start discovery" : "resume discovery", 's');
     dialog::add_action([&ds] { ds.activate(); });
     }
   else {
@@ -489,13 +489,29 @@ EX void showQuotientConfig3() {
     dialog::add_action([&ds] { ds.suspend(); });
     }
 
-  auto& e = ds.experiment;
-  if(!e.Prime)
+  if(ds.running() && !finished) {
+    dialog::addItem(XLAT("cancel discovery"), 'c');
+    dialog::add_action([&ds] { ds.cancel(); });
+    }
+  else
     dialog::addBreak(100);
-  else {
-    string s = its(e.Prime);
-    if(e.wsquare) s += "²";
-    dialog::addInfo(s);
+
+  if(1) {
+    std::unique_lock<std::mutex> lk(ds.lock);
+    int done = 0;
+    string s;
+    for(auto& j: ds.jobs) {
+      if(j.state == 2) done++;
+      if(j.state == 1) {
+        if(s != "") s += ", ";
+        s += its(j.prime);
+        if(j.wsquare) s += "²";
+        }
+      }
+    if(ds.jobs.empty())
+      dialog::addBreak(100);
+    else
+      dialog::addInfo(XLAT("fields checked: %1/%2", its(done), its(isize(ds.jobs))) + (s == "" ? "" : " (" + s + ")"));
     }
     
   dialog::addBreak(100);
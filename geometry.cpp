@@ -268,6 +268,8 @@ struct geometry_information {
 
 #if CAP_SHAPES
 
+/* the shape cache (polygons.cpp, walk_cached_shapes) lists all the members from shSemiFloorSide to shReserved; update it when adding shapes here */
+
 sidearray<hpcshape> shSemiFloorSide;
 
 hpcshape 
@@ -482,6 +484,8 @@ hpcshape
   void prepare_basics();
   void prepare_compute3();
   void prepare_shapes();
+  bool load_shape_cache(const string& fname, const string& key);
+  void save_shape_cache(const string& fname, const string& key);
   void prepare_usershapes();
   void generate_faces();
 
@@ -1467,6 +1471,9 @@ EX string cgi_string() {
 #define IFINTRA(x,y) y
 #endif
 
+/** how many unused geometry_information objects are kept in cgis */
+EX int cgi_cache_limit = 3;
+
 EX void check_cgi() {
   string s = cgi_string();
   
@@ -1479,7 +1486,7 @@ EX void check_cgi() {
   if(arcm::bm.alt_cgip[1]) arcm::bm.alt_cgip[1]->timestamp = ntimestamp;
   #endif
   
-  int limit = 3;
+  int limit = cgi_cache_limit;
   for(auto& t: cgis) if(t.second.use_count || t.second.timestamp == ntimestamp) limit++;
   if(isize(cgis) > limit) {
     vector<pair<int, string>> timestamps;
@@ -126,6 +126,55 @@ transmatrix hrmap_standard::relative_matrixc(cell *c2, cell *c1, const hyperpoin
   return relative_matrix_via_masters(c2, c1, hint);
   }
 
+/** \brief changed whenever heptagons are deleted, which invalidates every ancestor_index */
+EX int ancestor_generation;
+
+/** \brief the ancestor_index of a map is dropped when it grows larger than this */
+EX int ancestor_index_limit = 1<<17;
+
+ancestor_index::entry& ancestor_index::get(hrmap *m, heptagon *h) {
+  if(generation != ancestor_generation || isize(data) > ancestor_index_limit) {
+    data.clear(); generation = ancestor_generation;
+    }
+  auto it = data.find(h);
+  if(it != data.end()) return it->second;
+
+  /* find the closest indexed ancestor (or the root), and index the path from there */
+  vector<heptagon*> path;
+  heptagon *at = h;
+  while(!data.count(at)) {
+    path.push_back(at);
+    heptagon *p = at->move(0);
+    if(!p || p->distance >= at->distance) break;
+    at = p;
+    }
+
+  for(int i=isize(path)-1; i>=0; i--) {
+    heptagon *v = path[i];
+    heptagon *p = v->move(0);
+    entry e;
+    if(!p || p->distance >= v->distance) {
+      e.jump = nullptr; e.depth = 0; e.T = e.iT = Id;
+      }
+    else {
+      max_drop = max(max_drop, v->distance - p->distance);
+      auto& ep = data.at(p);
+      e.depth = ep.depth + 1;
+      e.jump = p; e.T = m->adj(v, 0); e.iT = m->iadj(v, 0);
+      if(ep.jump) {
+        auto& ej = data.at(ep.jump);
+        if(ej.jump && ep.depth - ej.depth == ej.depth - data.at(ej.jump).depth) {
+          e.jump = ej.jump;
+          e.T = e.T * ep.T * ej.T;
+          e.iT = ej.iT * ep.iT * e.iT;
+          }
+        }
+      }
+    data[v] = e;
+    }
+  return data.at(h);
+  }
+
 transmatrix hrmap_standard::relative_matrixh(heptagon *h2, heptagon *h1, const hyperpoint& hint) {
 
   transmatrix gm = Id, where = Id;
@@ -133,6 +182,54 @@ transmatrix hrmap_standard::relative_matrixh(heptagon *h2, heptagon *h1, const h
 //bool hsol = false;
 //transmatrix sol;
 
+  /* the long vertical part of the path is done with the ancestor index; the heptagons can only be
+   * equal or adjacent when their distances are close, so we stop a bit earlier and continue step by step.
+   * The index is built lazily and not thread-safe, so other threads (e.g. RogueViz computing embeddings
+   * in parallel) take the step-by-step path below */
+  if(!closed_manifold && !quotient && !among(geometry, gFieldQuotient, gBring, gMacbeath) && !cryst && on_main_thread()) {
+    auto climb = [&] (heptagon*& h, int limit, bool left) {
+      auto& e = ancestors.get(this, h);
+      if(e.jump && e.jump->distance > limit) {
+        if(left) gm = gm * e.T; else where = e.iT * where;
+        h = e.jump;
+        return true;
+        }
+      if(e.depth && h->move(0)->distance > limit) {
+        if(left) gm = gm * adj(h, 0); else where = iadj(h, 0) * where;
+        h = h->move(0);
+        return true;
+        }
+      return false;
+      };
+    while(climb(h1, h2->distance + 2 * ancestors.max_drop + 2, true)) ;
+    while(climb(h2, h1->distance + 2 * ancestors.max_drop + 2, false)) ;
+
+    /* then climb both sides together, while they are neither equal nor adjacent; as in Myers' LCA search,
+     * both jump when the jump targets (at the same depth) are still apart, and otherwise both take one step,
+     * which takes O(log d) steps */
+    auto near = [] (heptagon *a, heptagon *b) {
+      if(a == b) return true;
+      for(int d=0; d<a->type; d++) if(a->move(d) == b) return true;
+      return false;
+      };
+    while(!near(h1, h2)) {
+      /* copies, since get() may drop the index */
+      auto e1 = ancestors.get(this, h1);
+      auto e2 = ancestors.get(this, h2);
+      if(!e1.depth || !e2.depth) break;
+      if(e1.depth > e2.depth) { gm = gm * adj(h1, 0); h1 = h1->move(0); }
+      else if(e2.depth > e1.depth) { where = iadj(h2, 0) * where; h2 = h2->move(0); }
+      else if(e1.jump && !near(e1.jump, e2.jump)) {
+        gm = gm * e1.T; where = e2.iT * where;
+        h1 = e1.jump; h2 = e2.jump;
+        }
+      else {
+        gm = gm * adj(h1, 0); where = iadj(h2, 0) * where;
+        h1 = h1->move(0); h2 = h2->move(0);
+        }
+      }
+    }
+
   set<heptagon*> visited;
   map<ld, vector<pair<heptagon*, transmatrix>>> hbdist;
 
@@ -1373,6 +1373,9 @@ EX void center_multiplayer_map(const vector<hyperpoint>& hs) {
 
 EX debugflag debug_map = {"graph_map"};
 
+/** \brief time taken by currentmap->draw_all(), in milliseconds, smoothed over recent frames */
+EX ld draw_all_ms;
+
 EX void drawthemap() {
   indenter_finish(debug_map, "drawthemap");
 
@@ -1472,7 +1475,10 @@ EX void drawthemap() {
   arrowtraps.clear();
 
   make_actual_view();
+  auto draw_start = std::chrono::steady_clock::now();
   currentmap->draw_all();
+  ld ms = std::chrono::duration<ld, std::milli>(std::chrono::steady_clock::now() - draw_start).count();
+  draw_all_ms = draw_all_ms * .9 + ms * .1;
   drawWormSegments();
   drawBlizzards();
   drawArrowTraps();
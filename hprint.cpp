@@ -66,6 +66,8 @@ struct hstream {
   virtual void write_chars(const char* c, size_t q) { while(q--) write_char(*(c++)); }
   virtual char read_char() = 0;
   virtual void read_chars(char* c, size_t q) { while(q--) *(c++) = read_char(); }
+  /** \brief read at most q chars, fewer only at the end of the stream; returns the number of chars read */
+  virtual size_t read_some(char* c, size_t q);
   virtual color_t get_vernum() { return vernum; }
   virtual void flush() {}
   
@@ -129,6 +131,13 @@ struct hstream_exception : hr_exception {
   hstream_exception(const std::string &s) : hr_exception(s) {}
   };
 
+inline size_t hstream::read_some(char* c, size_t q) {
+  size_t i = 0;
+  try { while(i < q) { c[i] = read_char(); i++; } }
+  catch(hstream_exception&) {}
+  return i;
+  }
+
 struct fhstream : hstream {
   FILE *f;
   explicit fhstream() { f = NULL; }
@@ -137,6 +146,7 @@ struct fhstream : hstream {
   void write_char(char c) override { write_chars(&c, 1); }
   void write_chars(const char* c, size_t i) override { if(fwrite(c, i, 1, f) != 1) throw hstream_exception(); }
   void read_chars(char* c, size_t i) override { if(fread(c, i, 1, f) != 1) throw hstream_exception(); }
+  size_t read_some(char* c, size_t i) override { return fread(c, 1, i, f); }
   char read_char() override { char c; read_chars(&c, 1); return c; }
   void flush() override { fflush(f); }
   };
@@ -147,6 +157,7 @@ struct shstream : hstream {
   explicit shstream(const string& t = "") : s(t) { pos = 0; vernum = VERNUM_HEX; }
   void write_char(char c) override { s += c; }
   char read_char() override { if(pos == isize(s)) throw hstream_exception(); return s[pos++]; }
+  size_t read_some(char* c, size_t i) override { i = min<size_t>(i, isize(s) - pos); memcpy(c, &s[pos], i); pos += i; return i; }
   };
 
 inline void print(hstream& hs) {}
@@ -2058,4 +2058,334 @@ EX ld compute_area(const vector<hyperpoint>& v) {
   return area;
   }
 
+
+/** \brief batch operations on arrays of points and matrices
+ *
+ *  The kernels are chosen at startup: AVX2 or SSE2 where the CPU supports them,
+ *  and plain loops otherwise. Only the first MXDIM coordinates are used, just like
+ *  in the operators on hr::hyperpoint and hr::transmatrix.
+ */
+
+#if HDR
+struct batch_kernels {
+  const char *name;
+  /** out[i] = T * in[i] for the first dim coordinates (in may equal out) */
+  void (*apply)(const transmatrix& T, const hyperpoint *in, hyperpoint *out, int qty, int dim);
+  /** R = T * U */
+  void (*compose)(const transmatrix& T, const transmatrix& U, transmatrix& R, int dim);
+  /** out[i] = sum over j<dim of w[j] * (in[i][j] - a[j])^2 */
+  void (*weighted_sqdist)(const hyperpoint& a, const hyperpoint& w, const hyperpoint *in, ld *out, int qty, int dim);
+  /** squared Euclidean distance between the rows a and b of length n; once the partial sum exceeds limit,
+   *  the kernel may stop and return it (the result is then only known to be > limit) */
+  double (*row_sqdist)(const double *a, const double *b, int n, double limit);
+  };
+#endif
+
+void scalar_apply(const transmatrix& T, const hyperpoint *in, hyperpoint *out, int qty, int dim) {
+  for(int q=0; q<qty; q++) {
+    hyperpoint h = in[q];
+    for(int i=0; i<dim; i++) {
+      ld z = 0;
+      for(int j=0; j<dim; j++) z += T[i][j] * h[j];
+      out[q][i] = z;
+      }
+    }
+  }
+
+void scalar_compose(const transmatrix& T, const transmatrix& U, transmatrix& R, int dim) {
+  transmatrix res;
+  for(int i=0; i<dim; i++) for(int j=0; j<dim; j++) {
+    res[i][j] = 0;
+    for(int k=0; k<dim; k++) res[i][j] += T[i][k] * U[k][j];
+    }
+  R = res;
+  }
+
+void scalar_weighted_sqdist(const hyperpoint& a, const hyperpoint& w, const hyperpoint *in, ld *out, int qty, int dim) {
+  for(int q=0; q<qty; q++) {
+    ld res = 0;
+    for(int i=0; i<dim; i++) res += w[i] * squar(in[q][i] - a[i]);
+    out[q] = res;
+    }
+  }
+
+/* row_sqdist checks the partial sum after every block of this many columns */
+static constexpr int row_block = 16;
+
+double scalar_row_sqdist(const double *a, const double *b, int n, double limit) {
+  double diff = 0;
+  int k = 0;
+  for(; k+row_block <= n; k += row_block) {
+    for(int j=k; j<k+row_block; j++) diff += squar(a[j] - b[j]);
+    if(diff > limit) return diff;
+    }
+  for(; k<n; k++) diff += squar(a[k] - b[k]);
+  return diff;
+  }
+
+batch_kernels scalar_kernels = { "scalar", scalar_apply, scalar_compose, scalar_weighted_sqdist, scalar_row_sqdist };
+
+#if CAP_SIMD && MAXMDIM == 4
+/* column j of T, restricted to dim coordinates */
+inline hyperpoint batch_column(const transmatrix& T, int j, int dim) {
+  hyperpoint c;
+  for(int i=0; i<4; i++) c[i] = (i < dim && j < dim) ? T[i][j] : 0;
+  return c;
+  }
+
+void sse2_apply(const transmatrix& T, const hyperpoint *in, hyperpoint *out, int qty, int dim) {
+  __m128d clo[4], chi[4];
+  for(int j=0; j<4; j++) {
+    hyperpoint c = batch_column(T, j, dim);
+    clo[j] = _mm_loadu_pd(&c[0]); chi[j] = _mm_loadu_pd(&c[2]);
+    }
+  for(int q=0; q<qty; q++) {
+    const ld *h = &in[q][0];
+    __m128d lo = _mm_setzero_pd(), hi = _mm_setzero_pd();
+    for(int j=0; j<dim; j++) {
+      __m128d b = _mm_set1_pd(h[j]);
+      lo = _mm_add_pd(lo, _mm_mul_pd(clo[j], b));
+      hi = _mm_add_pd(hi, _mm_mul_pd(chi[j], b));
+      }
+    _mm_storeu_pd(&out[q][0], lo);
+    _mm_storeu_pd(&out[q][2], hi);
+    }
+  }
+
+void sse2_compose(const transmatrix& T, const transmatrix& U, transmatrix& R, int dim) {
+  __m128d ulo[4], uhi[4];
+  for(int k=0; k<dim; k++) ulo[k] = _mm_loadu_pd(&U[k][0]), uhi[k] = _mm_loadu_pd(&U[k][2]);
+  transmatrix res;
+  for(int i=0; i<dim; i++) {
+    __m128d lo = _mm_setzero_pd(), hi = _mm_setzero_pd();
+    for(int k=0; k<dim; k++) {
+      __m128d b = _mm_set1_pd(T[i][k]);
+      lo = _mm_add_pd(lo, _mm_mul_pd(ulo[k], b));
+      hi = _mm_add_pd(hi, _mm_mul_pd(uhi[k], b));
+      }
+    _mm_storeu_pd(&res[i][0], lo);
+    _mm_storeu_pd(&res[i][2], hi);
+    }
+  for(int i=0; i<dim; i++) R[i] = res[i];
+  }
+
+/* all bits set in the lanes below dim: the unused coordinates may hold anything, even NaN */
+inline void batch_lane_mask(int dim, ld *mask) {
+  for(int i=0; i<4; i++) { uint64_t bits = i < dim ? ~uint64_t(0) : 0; memcpy(mask+i, &bits, sizeof(bits)); }
+  }
+
+void sse2_weighted_sqdist(const hyperpoint& a, const hyperpoint& w, const hyperpoint *in, ld *out, int qty, int dim) {
+  ld mask[4]; batch_lane_mask(dim, mask);
+  __m128d alo = _mm_loadu_pd(&a[0]), ahi = _mm_loadu_pd(&a[2]);
+  __m128d wlo = _mm_loadu_pd(&w[0]), whi = _mm_loadu_pd(&w[2]);
+  __m128d mlo = _mm_loadu_pd(mask), mhi = _mm_loadu_pd(mask+2);
+  for(int q=0; q<qty; q++) {
+    __m128d dlo = _mm_sub_pd(_mm_loadu_pd(&in[q][0]), alo);
+    __m128d dhi = _mm_sub_pd(_mm_loadu_pd(&in[q][2]), ahi);
+    __m128d s = _mm_add_pd(_mm_and_pd(_mm_mul_pd(_mm_mul_pd(dlo, dlo), wlo), mlo), _mm_and_pd(_mm_mul_pd(_mm_mul_pd(dhi, dhi), whi), mhi));
+    out[q] = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+  }
+
+double sse2_row_sqdist(const double *a, const double *b, int n, double limit) {
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  double res[2];
+  int k = 0;
+  for(; k+row_block <= n; k += row_block) {
+    for(int j=k; j<k+row_block; j+=4) {
+      __m128d d0 = _mm_sub_pd(_mm_loadu_pd(a+j), _mm_loadu_pd(b+j));
+      __m128d d1 = _mm_sub_pd(_mm_loadu_pd(a+j+2), _mm_loadu_pd(b+j+2));
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+      }
+    _mm_storeu_pd(res, _mm_add_pd(acc0, acc1));
+    if(res[0] + res[1] > limit) return res[0] + res[1];
+    }
+  _mm_storeu_pd(res, _mm_add_pd(acc0, acc1));
+  double diff = res[0] + res[1];
+  for(; k<n; k++) diff += squar(a[k] - b[k]);
+  return diff;
+  }
+
+batch_kernels sse2_kernels = { "sse2", sse2_apply, sse2_compose, sse2_weighted_sqdist, sse2_row_sqdist };
+
+__attribute__((target("avx2,fma")))
+void avx2_apply(const transmatrix& T, const hyperpoint *in, hyperpoint *out, int qty, int dim) {
+  __m256d col[4];
+  for(int j=0; j<4; j++) {
+    hyperpoint c = batch_column(T, j, dim);
+    col[j] = _mm256_loadu_pd(&c[0]);
+    }
+  if(dim == 4) for(int q=0; q<qty; q++) {
+    const ld *h = &in[q][0];
+    __m256d r = _mm256_mul_pd(col[0], _mm256_broadcast_sd(h));
+    r = _mm256_fmadd_pd(col[1], _mm256_broadcast_sd(h+1), r);
+    r = _mm256_fmadd_pd(col[2], _mm256_broadcast_sd(h+2), r);
+    r = _mm256_fmadd_pd(col[3], _mm256_broadcast_sd(h+3), r);
+    _mm256_storeu_pd(&out[q][0], r);
+    }
+  else for(int q=0; q<qty; q++) {
+    const ld *h = &in[q][0];
+    __m256d r = _mm256_setzero_pd();
+    for(int j=0; j<dim; j++) r = _mm256_fmadd_pd(col[j], _mm256_broadcast_sd(h+j), r);
+    _mm256_storeu_pd(&out[q][0], r);
+    }
+  }
+
+__attribute__((target("avx2,fma")))
+void avx2_compose(const transmatrix& T, const transmatrix& U, transmatrix& R, int dim) {
+  __m256d u[4];
+  for(int k=0; k<dim; k++) u[k] = _mm256_loadu_pd(&U[k][0]);
+  __m256d res[4];
+  for(int i=0; i<dim; i++) {
+    __m256d r = _mm256_setzero_pd();
+    for(int k=0; k<dim; k++) r = _mm256_fmadd_pd(u[k], _mm256_broadcast_sd(&T[i][k]), r);
+    res[i] = r;
+    }
+  for(int i=0; i<dim; i++) _mm256_storeu_pd(&R[i][0], res[i]);
+  }
+
+__attribute__((target("avx2,fma")))
+void avx2_weighted_sqdist(const hyperpoint& a, const hyperpoint& w, const hyperpoint *in, ld *out, int qty, int dim) {
+  ld mask[4]; batch_lane_mask(dim, mask);
+  __m256d av = _mm256_loadu_pd(&a[0]), wv = _mm256_loadu_pd(&w[0]), mv = _mm256_loadu_pd(mask);
+  for(int q=0; q<qty; q++) {
+    __m256d d = _mm256_sub_pd(_mm256_loadu_pd(&in[q][0]), av);
+    __m256d s = _mm256_and_pd(_mm256_mul_pd(_mm256_mul_pd(d, d), wv), mv);
+    __m128d t = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    out[q] = _mm_cvtsd_f64(_mm_add_sd(t, _mm_unpackhi_pd(t, t)));
+    }
+  }
+
+__attribute__((target("avx2,fma")))
+inline double avx2_hsum(__m256d a, __m256d b) {
+  double res[4];
+  _mm256_storeu_pd(res, _mm256_add_pd(a, b));
+  return (res[0] + res[1]) + (res[2] + res[3]);
+  }
+
+__attribute__((target("avx2,fma")))
+double avx2_row_sqdist(const double *a, const double *b, int n, double limit) {
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  int k = 0;
+  for(; k+row_block <= n; k += row_block) {
+    for(int j=k; j<k+row_block; j+=8) {
+      __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(a+j), _mm256_loadu_pd(b+j));
+      __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(a+j+4), _mm256_loadu_pd(b+j+4));
+      acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+      acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+      }
+    double t = avx2_hsum(acc0, acc1);
+    if(t > limit) return t;
+    }
+  double diff = avx2_hsum(acc0, acc1);
+  for(; k<n; k++) diff += squar(a[k] - b[k]);
+  return diff;
+  }
+
+batch_kernels avx2_kernels = { "avx2", avx2_apply, avx2_compose, avx2_weighted_sqdist, avx2_row_sqdist };
+#endif
+
+batch_kernels *pick_batch_kernels() {
+  #if CAP_SIMD && MAXMDIM == 4
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return &avx2_kernels;
+  if(__builtin_cpu_supports("sse2")) return &sse2_kernels;
+  #endif
+  return &scalar_kernels;
+  }
+
+/** the kernels used by the batch operations */
+EX batch_kernels *batch_ops = pick_batch_kernels();
+
+/** select the batch kernels by name (scalar, sse2, avx2); the best one supported is used by default */
+EX bool set_batch_kernels(const string& s) {
+  if(s == "scalar") { batch_ops = &scalar_kernels; return true; }
+  #if CAP_SIMD && MAXMDIM == 4
+  if(s == "sse2") { batch_ops = &sse2_kernels; return true; }
+  if(s == "avx2" && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) { batch_ops = &avx2_kernels; return true; }
+  #endif
+  return false;
+  }
+
+/** out[i] = T * in[i] for i < qty; in and out may be the same array */
+EX void apply_batch(const transmatrix& T, const hyperpoint *in, hyperpoint *out, int qty) {
+  batch_ops->apply(T, in, out, qty, MXDIM);
+  }
+
+EX void apply_batch(const transmatrix& T, vector<hyperpoint>& v) {
+  batch_ops->apply(T, v.data(), v.data(), isize(v), MXDIM);
+  }
+
+/** out[i] = T[0] * ... * T[i], i.e., the prefix products of a chain of matrices */
+EX void compose_chain(const transmatrix *T, transmatrix *out, int qty) {
+  if(qty <= 0) return;
+  out[0] = T[0];
+  for(int i=1; i<qty; i++) batch_ops->compose(out[i-1], T[i], out[i], MXDIM);
+  }
+
+/** the product T[0] * ... * T[qty-1] */
+EX transmatrix compose_all(const transmatrix *T, int qty) {
+  transmatrix R = Id;
+  for(int i=0; i<qty; i++) batch_ops->compose(R, T[i], R, MXDIM);
+  return R;
+  }
+
+/** the weights which turn weighted_sqdist into intval */
+hyperpoint intval_weights() {
+  hyperpoint w;
+  for(int i=0; i<MAXMDIM; i++) w[i] = i < MDIM ? sig(i) : 0;
+  return w;
+  }
+
+/** out[i] = intval(h, in[i]) */
+EX void intval_batch(const hyperpoint& h, const hyperpoint *in, ld *out, int qty) {
+  if(elliptic) {
+    for(int i=0; i<qty; i++) out[i] = intval(h, in[i]);
+    return;
+    }
+  batch_ops->weighted_sqdist(h, intval_weights(), in, out, qty, MDIM);
+  }
+
+/** normalize all the points in the array */
+EX void normalize_batch(hyperpoint *h, int qty) {
+  if(gproduct) return;
+  if(translatable) {
+    for(int i=0; i<qty; i++) { ld Z = h[i][LDIM]; for(int c=0; c<MXDIM; c++) h[i][c] /= Z; }
+    return;
+    }
+  if(sl2 || in_e2xe() || !(sphere || hyperbolic)) {
+    for(int i=0; i<qty; i++) h[i] = normalize(h[i]);
+    return;
+    }
+  /* zlevel is computed as intval from the origin, in chunks */
+  const int chunk = 256;
+  ld q[chunk];
+  hyperpoint zero = Hypc, w = intval_weights();
+  for(int s=0; s<qty; s+=chunk) {
+    int n = min(chunk, qty-s);
+    batch_ops->weighted_sqdist(zero, w, h+s, q, n, MDIM);
+    for(int i=0; i<n; i++) {
+      auto& H = h[s+i];
+      ld Z = sphere ? sqrt(q[i]) : (H[LDIM] < 0 ? -1 : 1) * sqrt(-q[i]);
+      for(int c=0; c<MXDIM; c++) H[c] /= Z;
+      }
+    }
+  }
+
+#if CAP_COMMANDLINE
+int read_batch_args() {
+  using namespace arg;
+  if(0) ;
+  else if(argis("-batch-kernels")) {
+    shift();
+    if(!set_batch_kernels(args())) println(hlog, "unknown or unsupported batch kernels: ", args());
+    }
+  else return 1;
+  return 0;
+  }
+
+auto ah_batch = addHook(hooks_args, 100, read_batch_args);
+#endif
+
 }
@@ -3303,36 +3303,32 @@ EX namespace dq {
     return hashmix_to(bucketer(T.h), hr::bucketer(T.shift));
     }
 
-  EX set<heptagon*> visited;
+  EX epoch_set<heptagon*> visited;
   EX void enqueue(heptagon *h, const shiftmatrix& T) {
-    if(!h || visited.count(h)) { return; }
-    visited.insert(h);
+    if(!h || !visited.insert(h)) { return; }
     drawqueue.emplace(h, T);
     }  
 
-  EX set<buckethash_t> visited_by_matrix;
+  EX epoch_set<buckethash_t> visited_by_matrix;
   EX void enqueue_by_matrix(heptagon *h, const shiftmatrix& T) {
     if(!h) return;
     buckethash_t b = bucketer(T * tile_center());
-    if(visited_by_matrix.count(b)) { return; }
-    visited_by_matrix.insert(b);
+    if(!visited_by_matrix.insert(b)) { return; }
     drawqueue.emplace(h, T);
     }
 
   EX queue<pair<cell*, shiftmatrix>> drawqueue_c;
-  EX set<cell*> visited_c;
+  EX epoch_set<cell*> visited_c;
 
   EX void enqueue_c(cell *c, const shiftmatrix& T) {
-    if(!c || visited_c.count(c)) { return; }
-    visited_c.insert(c);
+    if(!c || !visited_c.insert(c)) { return; }
     drawqueue_c.emplace(c, T);
     }
 
   EX void enqueue_by_matrix_c(cell *c, const shiftmatrix& T) {
     if(!c) return;
     buckethash_t b = bucketer(T * tile_center());
-    if(visited_by_matrix.count(b)) { return; }
-    visited_by_matrix.insert(b);
+    if(!visited_by_matrix.insert(b)) { return; }
     drawqueue_c.emplace(c, T);
     }
   
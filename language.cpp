@@ -343,53 +343,126 @@ void parrep(string& x, string w, stringpar p) {
 void postrep(string& s) {
   }
 
+/** \brief translations are cached: the basicrep result of each English string, split at the codes to be replaced by parrep */
+EX bool xlat_cache_enabled = true;
+
+/** the basicrep result of an English string: parts[0], slots[0], parts[1], ..., parts.back() */
+struct xlat_template {
+  vector<string> parts;
+  /** the codes to be replaced by parrep (such as "%a1"), and their parameter numbers */
+  vector<pair<string, int>> slots;
+  };
+
+std::unordered_map<string, xlat_template> xlat_templates;
+int xlat_cache_state = -1;
+
+/** \brief forget the cached translations; this happens automatically when the language or the genders change */
+EX void clear_xlat_cache() {
+  xlat_templates.clear();
+  xlat_cache_state = -1;
+  }
+
+/** all the codes replaced by parrep are '%', some letters, and the parameter number */
+xlat_template make_xlat_template(const string& t) {
+  xlat_template res;
+  string cur;
+  for(int i=0; i<isize(t); i++) {
+    if(t[i] == '%') {
+      int j = i+1;
+      while(j < isize(t) && t[j] != '%' && t[j] != ' ' && !(t[j] >= '0' && t[j] <= '9')) j++;
+      if(j < isize(t) && t[j] >= '1' && t[j] <= '9') {
+        res.parts.push_back(cur); cur = "";
+        res.slots.emplace_back(t.substr(i, j+1-i), t[j] - '0');
+        i = j;
+        continue;
+        }
+      }
+    cur += t[i];
+    }
+  res.parts.push_back(cur);
+  return res;
+  }
+
+string xlat_with(string x, std::initializer_list<const stringpar*> pars) {
+  if(!xlat_cache_enabled) {
+    basicrep(x);
+    int w = 0;
+    for(auto p: pars) parrep(x, its(++w), p->v);
+    postrep(x);
+    return x;
+    }
+  int state = (lang() << 4) | (playergender() << 1) | (vid.samegender ? 1 : 0);
+  if(state != xlat_cache_state) {
+    clear_xlat_cache();
+    xlat_cache_state = state;
+    }
+  auto it = xlat_templates.find(x);
+  if(it == xlat_templates.end()) {
+    string t = x;
+    basicrep(t);
+    it = xlat_templates.emplace(x, make_xlat_template(t)).first;
+    }
+  auto& t = it->second;
+  /* every code is replaced on its own, which gives the same result as parrep on the whole string */
+  string res = t.parts[0];
+  for(int i=0; i<isize(t.slots); i++) {
+    auto& sl = t.slots[i];
+    if(sl.second <= isize(pars)) {
+      string code = sl.first;
+      parrep(code, its(sl.second), pars.begin()[sl.second-1]->v);
+      res += code;
+      }
+    else res += sl.first;
+    res += t.parts[i+1];
+    }
+  postrep(res);
+  return res;
+  }
+
 /** translate the string @x */
 EX string XLAT(string x) { 
-  basicrep(x);
-  postrep(x);
-  return x;
+  return xlat_with(x, {});
   }
 EX string XLAT(string x, stringpar p1) { 
-  basicrep(x);
-  parrep(x,"1",p1.v);
-  postrep(x);
-  return x;
+  return xlat_with(x, {&p1});
   }
 EX string XLAT(string x, stringpar p1, stringpar p2) { 
-  basicrep(x);
-  parrep(x,"1",p1.v);
-  parrep(x,"2",p2.v);
-  postrep(x);
-  return x;
+  return xlat_with(x, {&p1, &p2});
   }
 EX string XLAT(string x, stringpar p1, stringpar p2, stringpar p3) { 
-  basicrep(x);
-  parrep(x,"1",p1.v);
-  parrep(x,"2",p2.v);
-  parrep(x,"3",p3.v);
-  postrep(x);
-  return x;
+  return xlat_with(x, {&p1, &p2, &p3});
   }
 EX string XLAT(string x, stringpar p1, stringpar p2, stringpar p3, stringpar p4) { 
-  basicrep(x);
-  parrep(x,"1",p1.v);
-  parrep(x,"2",p2.v);
-  parrep(x,"3",p3.v);
-  parrep(x,"4",p4.v);
-  postrep(x);
-  return x;
+  return xlat_with(x, {&p1, &p2, &p3, &p4});
   }
 EX string XLAT(string x, stringpar p1, stringpar p2, stringpar p3, stringpar p4, stringpar p5) { 
-  basicrep(x);
-  parrep(x,"1",p1.v);
-  parrep(x,"2",p2.v);
-  parrep(x,"3",p3.v);
-  parrep(x,"4",p4.v);
-  parrep(x,"5",p5.v);
-  postrep(x);
-  return x;
+  return xlat_with(x, {&p1, &p2, &p3, &p4, &p5});
+  }
+
+/** \brief measure the speed of XLAT, with and without the cache */
+EX void xlat_benchmark(int qty) {
+  bool b = xlat_cache_enabled;
+  for(int enabled: {0, 1}) {
+    xlat_cache_enabled = enabled;
+    clear_xlat_cache();
+    size_t total = 0;
+    int t0 = SDL_GetTicks();
+    for(int i=0; i<qty; i++) {
+      total += XLAT("main menu").size();
+      total += XLAT("You kill %the1.", moYeti).size();
+      total += XLAT("%The1 is destroyed!", moRatling).size();
+      total += XLAT("You collect %the1. (%2)", itDiamond, its(i & 15)).size();
+      }
+    int t1 = SDL_GetTicks();
+    println(hlog, "XLAT benchmark: cache ", enabled ? "on" : "off", ": ", 4 * qty, " calls in ", t1-t0, " ms, ",
+      hr::format("%.0f", 4 * qty * 1000. / max(t1-t0, 1)), " calls/s (", int(total), ")");
+    }
+  xlat_cache_enabled = b;
   }
 
+auto ah_xlat = arg::add3("-xlat-bench", [] { arg::shift(); xlat_benchmark(arg::argi()); })
+  + arg::add2("-xlat-cache", [] { arg::shift(); xlat_cache_enabled = arg::argi(); clear_xlat_cache(); });
+
 EX const char* XLAT1_to(string x, int language) {
 #if CAP_TRANS
   const fullnoun *N = findInHashTable(x, all_nouns);
@@ -210,6 +210,89 @@ template<class T> struct connection_table {
     }
   };
 
+/** \brief Slab allocator backing tailored_alloc.
+ *
+ *  Cells and heptagons are carved out of large chunks. Freed objects are kept on
+ *  per-size free lists (the size depends only on the degree, so there are few size
+ *  classes), so tailored_delete() never calls free(). Once nothing allocated from
+ *  the pool is alive anymore, clearCellMemory() returns all the chunks at once.
+ */
+struct tailored_pool {
+  /** \brief all sizes are rounded up to this */
+  static constexpr size_t granularity = alignof(ld) > alignof(void*) ? alignof(ld) : alignof(void*);
+  static constexpr size_t chunk_size = 1 << 18;
+
+  /** \brief all chunks allocated */
+  vector<char*> chunks;
+  /** \brief free_lists[i] is the intrusive list of freed objects of size i * granularity */
+  vector<void*> free_lists;
+  /** \brief the unused part of the last chunk */
+  char *bump = nullptr, *bump_end = nullptr;
+
+  size_t live_objects = 0, live_bytes = 0, free_bytes = 0, wasted_bytes = 0;
+  size_t alloc_calls = 0, reused = 0, bulk_releases = 0;
+
+  static size_t size_class(size_t b) { return (b + granularity - 1) / granularity; }
+
+  void *alloc(size_t b) {
+    size_t sc = size_class(b);
+    b = sc * granularity;
+    alloc_calls++; live_objects++; live_bytes += b;
+    if(sc < free_lists.size() && free_lists[sc]) {
+      void *res = free_lists[sc];
+      free_lists[sc] = *(void**) res;
+      free_bytes -= b; reused++;
+      return res;
+      }
+    if(size_t(bump_end - bump) < b) {
+      /* the tail is too small for this object; since the size classes depend on the degree only, it would hardly ever be reused */
+      wasted_bytes += bump_end - bump;
+      bump = new char[chunk_size];
+      bump_end = bump + chunk_size;
+      chunks.push_back(bump);
+      }
+    void *res = bump;
+    bump += b;
+    return res;
+    }
+
+  void push_free(void *p, size_t sc) {
+    if(sc >= free_lists.size()) free_lists.resize(sc+1, nullptr);
+    *(void**) p = free_lists[sc];
+    free_lists[sc] = p;
+    free_bytes += sc * granularity;
+    }
+
+  void dealloc(void *p, size_t b) {
+    size_t sc = size_class(b);
+    push_free(p, sc);
+    live_objects--; live_bytes -= sc * granularity;
+    }
+
+  size_t reserved_bytes() { return chunks.size() * chunk_size; }
+
+  /** \brief the fraction of the reserved memory which is on the free lists or wasted at the ends of the chunks */
+  double fragmentation() { return reserved_bytes() ? (free_bytes + wasted_bytes) * 1. / reserved_bytes() : 0; }
+
+  /** \brief release all chunks in bulk; does nothing if any object is still alive */
+  bool release_if_unused() {
+    if(live_objects || chunks.empty()) return false;
+    for(char *ch: chunks) delete[] ch;
+    chunks.clear();
+    free_lists.clear();
+    bump = bump_end = nullptr;
+    free_bytes = wasted_bytes = 0;
+    bulk_releases++;
+    return true;
+    }
+  };
+
+extern tailored_pool tailored_memory;
+
+template<class T> size_t tailored_size(int degree) {
+  return offsetof(T, c) + offsetof(connection_table<T>, move_table) + sizeof(T*) * degree + degree;
+  }
+
 /** \brief Allocate a class T with a connection_table, but with only `degree` connections. 
  *
  *  Also set yet unknown connections to NULL.
@@ -221,8 +304,8 @@ template<class T> struct connection_table {
 template<class T> T* tailored_alloc(int degree) {
   T* result;
 #ifndef NO_TAILORED_ALLOC
-  int b = offsetof(T, c) + offsetof(connection_table<T>, move_table) + sizeof(T*) * degree + degree;
-  result = (T*) new char[b];
+  static_assert(alignof(T) <= tailored_pool::granularity, "tailored_pool alignment");
+  result = (T*) tailored_memory.alloc(tailored_size<T>(degree));
   new (result) T();
 #else
   result = new T;
@@ -234,8 +317,13 @@ template<class T> T* tailored_alloc(int degree) {
 
 /** \brief Counterpart to hr::tailored_alloc(). */
 template<class T> void tailored_delete(T* x) {
-  x->~T();  
-  delete[] ((char*) (x));
+#ifndef NO_TAILORED_ALLOC
+  int degree = x->type;
+  x->~T();
+  tailored_memory.dealloc(x, tailored_size<T>(degree));
+#else
+  delete x;
+#endif
   }
 
 static constexpr struct wstep_t {} wstep = {};
@@ -428,11 +516,71 @@ struct cell : gcell {
 typedef walker<heptagon> heptspin;
 typedef walker<cell> cellwalker;
 
+inline uint64_t epoch_key(const void *p) { return (uint64_t) (uintptr_t) p; }
+inline uint64_t epoch_key(uint64_t x) { return x; }
+
+/** \brief an open-addressing set which is cleared in O(1) by bumping the epoch
+ *
+ *  Slots whose stamp differs from the current epoch are considered empty, so
+ *  clearing neither touches nor frees the table, and once the table has grown
+ *  to its working size, no allocations happen at all.
+ */
+template<class T> struct epoch_set {
+  vector<T> keys;
+  vector<unsigned> stamps;
+  unsigned epoch = 1;
+  int bits = 0;
+  int qty = 0;
+
+  size_t slot(const T& key) const { return (epoch_key(key) * 0x9E3779B97F4A7C15ull) >> (64 - bits); }
+
+  size_t find(const T& key) const {
+    size_t mask = keys.size() - 1;
+    size_t i = slot(key);
+    while(stamps[i] == epoch && keys[i] != key) i = (i+1) & mask;
+    return i;
+    }
+
+  int count(const T& key) const {
+    if(!qty) return 0;
+    size_t i = find(key);
+    return stamps[i] == epoch;
+    }
+
+  void grow() {
+    vector<T> old_keys = std::move(keys);
+    vector<unsigned> old_stamps = std::move(stamps);
+    bits = bits ? bits + 1 : 10;
+    keys.assign(size_t(1) << bits, T());
+    stamps.assign(size_t(1) << bits, 0);
+    for(size_t i=0; i<old_keys.size(); i++) if(old_stamps[i] == epoch) {
+      size_t j = find(old_keys[i]);
+      keys[j] = old_keys[i]; stamps[j] = epoch;
+      }
+    }
+
+  /** \brief insert key; returns false if it was already there */
+  bool insert(const T& key) {
+    if(2 * (qty+1) > isize(keys)) grow();
+    size_t i = find(key);
+    if(stamps[i] == epoch) return false;
+    keys[i] = key; stamps[i] = epoch; qty++;
+    return true;
+    }
+
+  int size() const { return qty; }
+
+  void clear() {
+    qty = 0;
+    if(!++epoch) { std::fill(stamps.begin(), stamps.end(), 0); epoch = 1; }
+    }
+  };
+
 /** \brief A structure useful when walking on the cell graph in arbitrary way, or listing cells in general.
   *
   * Only one celllister may be active at a time, using the stack semantics.
   * Only the most recently created one works; the previous one will resume 
-  * working when this one is destroyed.
+  * working when this one is destroyed. See bfs_lister for a BFS without this restriction.
   */
 struct manual_celllister {
   /** \brief list of cells in this list */
@@ -507,6 +655,55 @@ struct celllister : manual_celllister {
   int getdist(cell *c) { return dists[c->listindex]; }
   };
 
+/** \brief a frontier-based BFS over the cell graph
+ *
+ *  Unlike celllister, the visited set is kept in the lister rather than in the cells,
+ *  so any number of bfs_listers may be active at once, and the results are streamed
+ *  level by level instead of being collected in a list.
+ *
+ *  If generate is false, only the existing connections are followed (missing neighbors
+ *  are skipped), and large frontiers are expanded with parallel_for.
+ */
+struct bfs_lister {
+  epoch_set<cell*> visited;
+  /** cells at the current distance, and at the next one */
+  vector<cell*> frontier, next;
+  /** candidates found by each chunk during a parallel expansion */
+  vector<vector<cell*>> partial;
+  bool generate;
+  /** frontiers smaller than this are always expanded serially */
+  int parallel_threshold;
+
+  bfs_lister(bool _generate = true) : generate(_generate), parallel_threshold(4096) {}
+
+  void start(cell *orig) {
+    visited.clear(); frontier.clear();
+    visited.insert(orig); frontier.push_back(orig);
+    }
+
+  /** \brief replace the frontier with the cells at the next distance; returns false if there are none */
+  bool expand();
+
+  /** \brief call f(c, d) for the cells c at distance d from orig, in the same order and with the
+   *  same limits as celllister(orig, maxdist, maxcount, nullptr); stop early when f returns false
+   *  @return false if stopped by f
+   */
+  template<class T> bool stream(cell *orig, int maxdist, int maxcount, const T& f) {
+    start(orig);
+    if(!f(orig, 0)) return false;
+    int total = 1;
+    for(int d=1; d<=maxdist; d++) {
+      if(!expand()) break;
+      for(cell *c: frontier) if(!f(c, d)) return false;
+      total += isize(frontier);
+      if(total >= maxcount) break;
+      }
+    return true;
+    }
+
+  bool seen(cell *c) const { return visited.count(c); }
+  };
+
 /** \brief translate heptspins to cellwalkers and vice versa */
 static constexpr struct cth_t {} cth = {};
 inline heptspin operator+ (cellwalker cw, cth_t) { return heptspin(cw.at->master, cw.spin * DUALMUL, cw.mirrored); }
@@ -514,6 +711,48 @@ inline cellwalker operator+ (heptspin hs, cth_t) { return cellwalker(hs.at->c7,
 
 #endif
 
+tailored_pool tailored_memory;
+
+bool bfs_lister::expand() {
+  next.clear();
+  int N = isize(frontier);
+  #if CAP_THREAD
+  if(!generate && worker_threads > 1 && N >= parallel_threshold) {
+    /* the workers only read the graph and the visited set; the candidates are merged in order, so the result does not depend on the scheduling */
+    int chunks = worker_threads * 4;
+    partial.resize(chunks);
+    parallel_for(chunks, [&] (int a, int b) {
+      for(int k=a; k<b; k++) {
+        auto& p = partial[k];
+        p.clear();
+        for(int i=N*k/chunks; i<N*(k+1)/chunks; i++) {
+          cell *c = frontier[i];
+          for(int j=0; j<c->type; j++) {
+            cell *c2 = c->move(j);
+            if(c2 && !visited.count(c2)) p.push_back(c2);
+            }
+          }
+        }
+      }, 1);
+    for(int k=0; k<chunks; k++)
+      for(cell *c2: partial[k]) if(visited.insert(c2)) next.push_back(c2);
+    swap(frontier, next);
+    return !frontier.empty();
+    }
+  #endif
+  for(cell *c: frontier) {
+    if(generate) {
+      forCellCM(c2, c) if(visited.insert(c2)) next.push_back(c2);
+      }
+    else for(int j=0; j<c->type; j++) {
+      cell *c2 = c->move(j);
+      if(c2 && visited.insert(c2)) next.push_back(c2);
+      }
+    }
+  swap(frontier, next);
+  return !frontier.empty();
+  }
+
 EX bool proper(cell *c, int d) { return d >= 0 && d < c->type; }
 
 /** return b-a, as in, a number x such that a+x == b. */
@@ -818,7 +818,7 @@ struct fhstream;
 EX namespace mapstream {
 #if CAP_EDIT
 
-  EX std::map<cell*, int> cellids;
+  EX std::unordered_map<cell*, int> cellids;
   EX vector<cell*> cellbyid;
   EX vector<char> relspin;
   
@@ -1135,7 +1135,181 @@ EX namespace mapstream {
     return (closed_manifold || euclid || mproduct || arcm::in() || sol || INVERSE) ? currentmap->gamestart() : cwt.at->master->c7;
     }
 
-#if CAP_EDIT  
+#if CAP_EDIT
+  /** \brief the first version which saves the cells as a table (save_cell_table) rather than one record per cell */
+  static constexpr int bulk_cell_table_version = 0xAA2D;
+
+  /** \brief starts the bulk cell table; only a sanity check, the format is given by the version */
+  static constexpr unsigned char bulk_cell_table_marker = 0xFF;
+
+  template<class T> void write_column(hstream& f, const vector<T>& v) {
+    if(!v.empty()) f.write_chars((const char*) v.data(), v.size() * sizeof(T));
+    }
+
+  template<class T> void read_column(hstream& f, vector<T>& v, int n) {
+    v.resize(n);
+    if(n) f.read_chars((char*) v.data(), n * sizeof(T));
+    }
+
+  /** \brief save cellbyid as a table: fixed-width fields are stored column by column, followed by the variable-size data of the cells which need it */
+  void save_cell_table(hstream& f, const vector<int32_t>& parent, const vector<char>& pdir, const vector<char>& cdir) {
+    int N = isize(cellbyid);
+    f.write_char(char(bulk_cell_table_marker));
+    f.write<int>(N);
+    write_column(f, parent);
+    write_column(f, pdir);
+    write_column(f, cdir);
+    vector<char> bytes(N);
+    auto byte_column = [&] (const auto& get) {
+      for(int i=0; i<N; i++) bytes[i] = get(cellbyid[i]);
+      write_column(f, bytes);
+      };
+    byte_column([] (cell *c) { return c->land; });
+    byte_column([] (cell *c) { return c->mondir; });
+    byte_column([] (cell *c) { return c->monst; });
+    byte_column([] (cell *c) { return c->wall; });
+    byte_column([] (cell *c) { return c->item; });
+    byte_column([] (cell *c) { return c->mpdist; });
+    byte_column([] (cell *c) { return c->stuntime; });
+    byte_column([] (cell *c) { return c->hitpoints; });
+    byte_column([] (cell *c) { return c->wparam; });
+    vector<int32_t> ints(N);
+    for(int i=0; i<N; i++) ints[i] = cellbyid[i]->landparam;
+    write_column(f, ints);
+    for(cell *c: cellbyid) {
+      if(c->monst == moTortoise)
+        f.write(tortoise::emap[c] = tortoise::getb(c));
+      if(dice::on(c)) {
+        auto& dat = dice::data[c];
+        f.write_char(dice::get_die_id(dat.which));
+        f.write_char(dat.val);
+        f.write_char(dat.dir);
+        f.write_char(dat.mirrored);
+        }
+      if(c->item == itBabyTortoise)
+        f.write(tortoise::babymap[c]);
+      if(inmirrororwall(c)) {
+        f.write_char(c->barleft);
+        f.write_char(c->barright);
+        f.write_char(c->bardir);
+        }
+      }
+    }
+
+  /** \brief save cellbyid as in the versions before bulk_cell_table_version: one record per cell, ending with -1 */
+  void save_cell_records(hstream& f, const vector<int32_t>& parent, const vector<char>& pdir, const vector<char>& cdir) {
+    for(int i=0; i<isize(cellbyid); i++) {
+      cell *c = cellbyid[i];
+      if(i) {
+        f.write(parent[i]);
+        f.write_char(pdir[i]);
+        f.write_char(cdir[i]);
+        }
+      f.write_char(c->land);
+      f.write_char(c->mondir);
+      f.write_char(c->monst);
+      if(c->monst == moTortoise)
+        f.write(tortoise::emap[c] = tortoise::getb(c));
+      f.write_char(c->wall);
+      if(dice::on(c)) {
+        auto& dat = dice::data[c];
+        f.write_char(dice::get_die_id(dat.which));
+        f.write_char(dat.val);
+        f.write_char(dat.dir);
+        f.write_char(dat.mirrored);
+        }
+      f.write_char(c->item);
+      if(c->item == itBabyTortoise)
+        f.write(tortoise::babymap[c]);
+      f.write_char(c->mpdist);
+      if(inmirrororwall(c)) {
+        f.write_char(c->barleft);
+        f.write_char(c->barright);
+        f.write_char(c->bardir);
+        }
+      f.write(c->wparam); f.write(c->landparam);
+      f.write_char(c->stuntime); f.write_char(c->hitpoints);
+      }
+    int32_t n = -1; f.write(n);
+    }
+
+  /** \brief the inverse of save_cell_table */
+  void load_cell_table(hstream& f) {
+    if((unsigned char) f.read_char() != bulk_cell_table_marker) throw hstream_exception("bad cell table marker");
+    int sub = mhybrid ? 2 : 0;
+    int N = f.get<int>();
+    if(N <= 0) throw hstream_exception("bad cell table");
+    vector<int32_t> parent;
+    vector<char> pdir, cdir;
+    read_column(f, parent, N);
+    read_column(f, pdir, N);
+    read_column(f, cdir, N);
+    cellbyid.reserve(N); relspin.reserve(N);
+    for(int i=0; i<N; i++) {
+      cell *c;
+      int rspin;
+      if(i == 0) {
+        c = currentmap->gamestart();
+        rspin = 0;
+        }
+      else {
+        if(parent[i] < 0 || parent[i] >= i) throw hstream_exception("bad parent in the cell table");
+        cell *c2 = cellbyid[parent[i]];
+        int dir = fixspin(relspin[parent[i]], pdir[i], c2->type - sub, f.vernum);
+        c = createMov(c2, dir);
+        rspin = gmod(c2->c.spin(dir) - cdir[i], c->type - sub);
+        if(GDIM == 3 && rspin && !mhybrid) {
+          println(hlog, "rspin in 3D");
+          throw hstream_exception();
+          }
+        }
+      cellbyid.push_back(c);
+      relspin.push_back(rspin);
+      }
+    vector<unsigned char> bytes;
+    auto byte_column = [&] (const auto& set) {
+      read_column(f, bytes, N);
+      for(int i=0; i<N; i++) set(cellbyid[i], bytes[i], relspin[i]);
+      };
+    byte_column([] (cell *c, int x, int rspin) { c->land = eLand(x); });
+    byte_column([sub, &f] (cell *c, int x, int rspin) { c->mondir = fixspin(rspin, (signed char) x, c->type - sub, f.vernum); });
+    byte_column([] (cell *c, int x, int rspin) { c->monst = eMonster(x); });
+    byte_column([] (cell *c, int x, int rspin) { c->wall = eWall(x); });
+    byte_column([] (cell *c, int x, int rspin) { c->item = eItem(x); });
+    byte_column([] (cell *c, int x, int rspin) { c->mpdist = x; });
+    byte_column([] (cell *c, int x, int rspin) { c->stuntime = x; });
+    byte_column([] (cell *c, int x, int rspin) { c->hitpoints = x; });
+    byte_column([] (cell *c, int x, int rspin) { c->wparam = x; });
+    vector<int32_t> ints;
+    read_column(f, ints, N);
+    for(int i=0; i<N; i++) cellbyid[i]->landparam = ints[i];
+    for(int i=0; i<N; i++) {
+      cell *c = cellbyid[i];
+      int rspin = relspin[i];
+      if(c->monst == moTortoise)
+        f.read(tortoise::emap[c]);
+      if(dice::on(c)) {
+        auto& dat = dice::data[c];
+        dat.which = dice::get_by_id(f.read_char());
+        dat.val = f.read_char();
+        dat.dir = f.read_char();
+        auto fs = get_facesides(dat.which);
+        dat.dir = fixspin(rspin, dat.dir / fs, c->type, f.vernum) * fs + (dat.dir % fs);
+        dat.mirrored = f.read_char();
+        }
+      if(c->item == itBabyTortoise)
+        f.read(tortoise::babymap[c]);
+      c->bardir = NOBARRIERS;
+      if(inmirrororwall(c)) {
+        c->barleft = (eLand) f.read_char();
+        c->barright = (eLand) f.read_char();
+        c->bardir = fixspin(rspin, f.read_char(), c->type, f.vernum);
+        }
+      if(patterns::whichPattern)
+        mapeditor::modelcell[patterns::getpatterninfo0(c).id] = c;
+      }
+    }
+
   void save_only_map(hstream& f) {
     f.write(patterns::whichPattern);
     save_geometry(f);
@@ -1173,49 +1347,11 @@ EX namespace mapstream {
     #if CAP_PORTALS
     if(intra::in) intra::prepare_need_to_save();
     #endif
+    /* the BFS tree: each cell is reached from a cell with a smaller id */
+    vector<int32_t> parent(1, -1);
+    vector<char> pdir(1, 0), cdir(1, 0);
     for(int i=0; i<isize(cellbyid); i++) {
       cell *c = cellbyid[i];
-      if(i) {
-        bool ok = false;
-        for(int j=0; j<c->type; j++) if(c->move(j) && cellids.count(c->move(j)) && 
-          cellids[c->move(j)] < i) {
-          int32_t i = cellids[c->move(j)];
-          f.write(i);
-          f.write_char(c->c.spin(j));
-          f.write_char(j);
-          ok = true;
-          break;
-          }
-        if(!ok) {
-          println(hlog, "parent not found for ", c, "!");
-          for(int j=0; j<c->type; j++) println(hlog, j, ": ", c->move(j), "; ", int(cellids.count(c->move(j)) ? cellids[c->move(j)] : -1));
-          throw hr_exception("parent not found");
-          }
-        }
-      f.write_char(c->land);
-      f.write_char(c->mondir);
-      f.write_char(c->monst);
-      if(c->monst == moTortoise)
-        f.write(tortoise::emap[c] = tortoise::getb(c));
-      f.write_char(c->wall);
-      if(dice::on(c)) {
-        auto& dat = dice::data[c];
-        f.write_char(dice::get_die_id(dat.which));
-        f.write_char(dat.val);
-        f.write_char(dat.dir);
-        f.write_char(dat.mirrored);
-        }
-      f.write_char(c->item);
-      if(c->item == itBabyTortoise)
-        f.write(tortoise::babymap[c]);
-      f.write_char(c->mpdist);
-      if(inmirrororwall(c)) {
-        f.write_char(c->barleft);
-        f.write_char(c->barright);
-        f.write_char(c->bardir);
-        }
-      f.write(c->wparam); f.write(c->landparam);
-      f.write_char(c->stuntime); f.write_char(c->hitpoints);
       bool blocked = false;
       #if CAP_PORTALS
       if(intra::in && isWall3(c) && !intra::need_to_save.count(c)) blocked = true;
@@ -1223,11 +1359,15 @@ EX namespace mapstream {
       if(!blocked)
       for(int j=0; j<c->type; j++) {
         cell *c2 = c->move(j);
-        if(c2 && c2->land != laNone && c2->land != laMemory) addToQueue(c2);
+        if(c2 && c2->land != laNone && c2->land != laMemory && !cellids.count(c2)) {
+          addToQueue(c2);
+          parent.push_back(i); pdir.push_back(j); cdir.push_back(c->c.spin(j));
+          }
         }
       }
+    if(f.vernum >= bulk_cell_table_version) save_cell_table(f, parent, pdir, cdir);
+    else save_cell_records(f, parent, pdir, cdir);
     printf("cells saved = %d\n", isize(cellbyid));
-    int32_t n = -1; f.write(n);
     int32_t id = cellids.count(cwt.at) ? cellids[cwt.at] : -1;
     f.write(id);
 
@@ -1379,7 +1519,8 @@ EX namespace mapstream {
       }
 
     int sub = mhybrid ? 2 : 0;
-    while(true) {
+    if(f.vernum >= bulk_cell_table_version) load_cell_table(f);
+    else while(true) {
       cell *c;
       int rspin;
       
@@ -1601,9 +1742,19 @@ EX namespace mapstream {
     n = -1; f.write(n);
     }
   
+  /** \brief save the map to fname; the file is gzip-compressed if its name ends with ".gz" */
   EX bool saveMap(const char *fname) {
     fhstream f(fname, "wb");
     if(!f.f) return false;
+    #if CAP_ZLIB
+    string s = fname;
+    if(isize(s) > 3 && s.substr(isize(s)-3) == ".gz") {
+      zlib_output_hstream zf(f, 6, true);
+      saveMap(zf);
+      zf.finish();
+      return true;
+      }
+    #endif
     saveMap(f);
     return true;
     }
@@ -1638,9 +1789,16 @@ EX namespace mapstream {
     save_usershapes(f);
     }
   
+  /** \brief load the map from fname, which may be gzip-compressed */
   EX bool loadMap(const string& fname) {
     fhstream f(fname, "rb");
     if(!f.f) return false;
+    #if CAP_ZLIB
+    if(is_gzip_file(f.f)) {
+      zlib_input_hstream zf(f);
+      return loadMap(zf);
+      }
+    #endif
     return loadMap(f);
     }
     
@@ -1688,6 +1846,25 @@ EX namespace mapstream {
       load_usershapes(f);
     return true;
     }
+
+  #if CAP_ZLIB
+  /** \brief time saving and loading the current map, as a plain file and as a gzip stream */
+  EX void map_io_benchmark(const string& fname) {
+    long long plain_size = 0;
+    for(string s: {fname, fname + ".gz"}) {
+      int t0 = SDL_GetTicks();
+      if(!saveMap(s.c_str())) { println(hlog, "cannot write ", s); return; }
+      int t1 = SDL_GetTicks();
+      loadMap(s);
+      int t2 = SDL_GetTicks();
+      long long size = 0;
+      if(FILE *f = fopen(s.c_str(), "rb")) { fseek(f, 0, SEEK_END); size = ftell(f); fclose(f); }
+      if(!plain_size) plain_size = size;
+      println(hlog, s, ": ", hr::format("%lld", size), " bytes, save ", t1-t0, " ms (", hr::format("%.1f", plain_size / 1048576. * 1000 / max(t1-t0, 1)),
+        " MB/s), load ", t2-t1, " ms (", hr::format("%.1f", plain_size / 1048576. * 1000 / max(t2-t1, 1)), " MB/s)");
+      }
+    }
+  #endif
   
 #endif
 EX }
@@ -3820,6 +3997,9 @@ int read_editor_args() {
   else if(argis("-pic")) { shift(); picfile = args(); }
   else if(argis("-load")) { PHASE(3); shift(); mapstream::loadMap(args()); }
   else if(argis("-save")) { PHASE(3); shift(); mapstream::saveMap(args().c_str()); }
+  #if CAP_ZLIB
+  else if(argis("-map-io-bench")) { PHASE(3); shift(); mapstream::map_io_benchmark(args()); }
+  #endif
   else if(argis("-d:draw")) { PHASE(3); 
     #if CAP_EDIT
     start_game();
@@ -62,37 +62,104 @@ EX namespace sn {
   inline hyperpoint decompress(compressed_point p) { return point3(p[0], p[1], p[2]); }
   inline compressed_point compress(hyperpoint h) { return make_array<float>(h[0], h[1], h[2]); }
 
+  /** the geodesic tables are memory-mapped where possible, so that even large tables are paged in only as needed */
   struct tabled_inverses {
     int PRECX, PRECY, PRECZ;
+    /** owned storage, used when the table could not be mapped, or has been built in memory */
     vector<compressed_point> tab;
+    /** points either into tab or into the mapping */
+    compressed_point *points;
     string fname;
     bool loaded;
     
+    void *mapping;
+    size_t mapped_size;
+    bool prefetching;
+    
+    bool open_table();
     void load();
+    void preload();
+    void resize(int X, int Y, int Z);
     hyperpoint get(ld ix, ld iy, ld iz, bool lazy);
     
-    compressed_point& get_int(int ix, int iy, int iz) { return tab[(iz*PRECY+iy)*PRECX+ix]; }
+    compressed_point& get_int(int ix, int iy, int iz) { return points[(size_t(iz)*PRECY+iy)*PRECX+ix]; }
   
     GLuint texture_id;
     bool toload;
     
     GLuint get_texture_id();
   
-    tabled_inverses(string s) : fname(s), texture_id(0), toload(true) {}  
+    tabled_inverses(string s) : points(nullptr), fname(s), loaded(false), mapping(nullptr), mapped_size(0), prefetching(false), texture_id(0), toload(true) {}  
     };
   #endif
   
-  void tabled_inverses::load() {
-    if(loaded) return;
-    FILE *f = fopen(find_file(fname).c_str(), "rb");
-    if(!f) { addMessage(XLAT("geodesic table missing")); pmodel = mdPerspective; return; }
+  void tabled_inverses::resize(int X, int Y, int Z) {
+    /* an existing mapping is not released, as the prefetch thread may still be reading it */
+    mapping = nullptr;
+    PRECX = X; PRECY = Y; PRECZ = Z;
+    tab.resize(size_t(X) * Y * Z);
+    points = &tab[0];
+    loaded = true;
+    }
+
+  /** open the table file without complaining; the header is followed by PRECX*PRECY*PRECZ points */
+  bool tabled_inverses::open_table() {
+    if(loaded) return true;
+    string s = find_file(fname);
+    #if CAP_MMAP
+    int fd = ::open(s.c_str(), O_RDONLY);
+    if(fd == -1) return false;
+    int header[3];
+    struct stat st;
+    if(::read(fd, header, sizeof(header)) != sizeof(header) || fstat(fd, &st) != 0) { ::close(fd); return false; }
+    size_t total = sizeof(header) + sizeof(compressed_point) * size_t(header[0]) * header[1] * header[2];
+    if(size_t(st.st_size) >= total) {
+      /* private and writable, so that devmods/solv-table.cpp can still improve a loaded table in place */
+      void *m = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if(m != MAP_FAILED) {
+        ::close(fd);
+        PRECX = header[0]; PRECY = header[1]; PRECZ = header[2];
+        mapping = m; mapped_size = total;
+        points = (compressed_point*) ((char*) m + sizeof(header));
+        loaded = true;
+        return true;
+        }
+      }
+    ::close(fd);
+    #endif
+    FILE *f = fopen(s.c_str(), "rb");
+    if(!f) return false;
     hr::ignore(fread(&PRECX, 4, 1, f));
     hr::ignore(fread(&PRECY, 4, 1, f));
     hr::ignore(fread(&PRECZ, 4, 1, f));
-    tab.resize(PRECX * PRECY * PRECZ);
-    hr::ignore(fread(&tab[0], sizeof(compressed_point) * PRECX * PRECY * PRECZ, 1, f));
+    tab.resize(size_t(PRECX) * PRECY * PRECZ);
+    hr::ignore(fread(&tab[0], sizeof(compressed_point) * tab.size(), 1, f));
     fclose(f);
-    loaded = true;    
+    points = &tab[0];
+    loaded = true;
+    return true;
+    }
+
+  void tabled_inverses::load() {
+    if(loaded) return;
+    if(!open_table()) { addMessage(XLAT("geodesic table missing")); pmodel = mdPerspective; return; }
+    }
+
+  /** called when a Solv-family map is created: map the table and let a background thread fault its pages in */
+  void tabled_inverses::preload() {
+    if(!open_table()) return;
+    #if CAP_MMAP && CAP_THREAD
+    if(!mapping || prefetching) return;
+    prefetching = true;
+    char *start = (char*) mapping;
+    size_t len = mapped_size;
+    std::thread([start, len] {
+      madvise(start, len, MADV_WILLNEED);
+      size_t page = sysconf(_SC_PAGESIZE);
+      volatile char sink = 0;
+      for(size_t i=0; i<len; i+=page) sink = sink + start[i];
+      }).detach();
+    #endif
     }
   
   hyperpoint tabled_inverses::get(ld ix, ld iy, ld iz, bool lazy) {
@@ -110,7 +177,7 @@ EX namespace sn {
     else {
   
       if(ix >= PRECX-1 || isnan(ix)) ix = PRECX-2;
-      if(iy >= PRECX-1 || isnan(iy)) iy = PRECX-2;
+      if(iy >= PRECY-1 || isnan(iy)) iy = PRECY-2;
       if(iz >= PRECZ-1 || isnan(iz)) iz = PRECZ-2;
       
       int ax = ix, bx = ax+1;
@@ -151,15 +218,16 @@ EX namespace sn {
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     
-    auto xbuffer = new glvertex[PRECZ*PRECY*PRECX];
+    size_t qty = size_t(PRECZ)*PRECY*PRECX;
+    auto xbuffer = new glvertex[qty];
     
-    for(int z=0; z<PRECZ*PRECY*PRECX; z++) {
-      auto& t = tab[z];
+    for(size_t z=0; z<qty; z++) {
+      auto& t = points[z];
       xbuffer[z] = glhr::makevertex(t[0], t[1], t[2]);
       }
     
     #if !ISWEB
-    glTexImage3D(GL_TEXTURE_3D, 0, 34836 /*GL_RGBA32F*/, PRECX, PRECX, PRECZ, 0, GL_RGBA, GL_FLOAT, xbuffer);
+    glTexImage3D(GL_TEXTURE_3D, 0, 34836 /*GL_RGBA32F*/, PRECX, PRECY, PRECZ, 0, GL_RGBA, GL_FLOAT, xbuffer);
     #else
     // glTexStorage3D(GL_TEXTURE_3D, 1, 34836 /*GL_RGBA32F*/, PRECX, PRECX, PRECZ);
     // glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, PRECX, PRECY, PRECZ, GL_RGBA, GL_FLOAT, xbuffer);
@@ -289,6 +357,7 @@ EX namespace sn {
         }
       
       origin = get_at(alt, alt3);
+      get_tabled().preload();
       }
     
     heptagon *altstep(heptagon *h, int d) {
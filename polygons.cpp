@@ -1176,6 +1176,334 @@ length_adjusted_shapes& geometry_information::get_lash(ld len) {
   return res;
   }
 
+/** directory for the on-disk cache of the shape tables computed by prepare_shapes(); empty = no cache */
+EX string shape_cache_dir;
+
+EX debugflag debug_shape_cache = {"shape_cache"};
+
+/** increase when anything saved in the shape cache changes */
+static constexpr int SHAPE_CACHE_VERSION = 1;
+
+/** the name of the shape cache file for the current geometry, or "" if the current geometry should not be cached */
+string shape_cache_file(string& key) {
+  if(shape_cache_dir == "") return "";
+  if(IRREGULAR) return "";
+  key = cgi_string();
+  /* the ARB number is only unique within a single run */
+  auto pos = key.find("ARB: ");
+  if(pos != string::npos) {
+    if(arb::current.filename == "") return "";
+    string a = "ARB: " + its(arb::current.order) + "; ";
+    pos = key.find(a);
+    if(pos == string::npos) return "";
+    key.replace(pos, isize(a), "ARBF: " + arb::current.filename + "; ");
+    }
+  unsigned long long h = 14695981039346656037ULL;
+  for(char c: key) h = (h ^ (unsigned char) c) * 1099511628211ULL;
+  return shape_cache_dir + "/shapes-" + hr::format("%016llx", h) + ".bin";
+  }
+
+/** reads from a memory block, e.g., a memory-mapped file */
+struct memory_hstream : hstream {
+  const char *p, *end;
+  memory_hstream(const char *b, size_t size) : p(b), end(b + size) {}
+  void write_char(char c) override { throw hstream_exception("read-only"); }
+  void read_chars(char* c, size_t q) override { if(size_t(end - p) < q) throw hstream_exception(); memcpy(c, p, q); p += q; }
+  char read_char() override { char c; read_chars(&c, 1); return c; }
+  };
+
+template<class T> void hwrite_block(hstream& f, const vector<T>& v) {
+  f.write<int>(isize(v));
+  f.write_chars((const char*) v.data(), sizeof(T) * v.size());
+  }
+
+template<class T> void hread_block(hstream& f, vector<T>& v) {
+  int n = f.get<int>();
+  if(n < 0) throw hstream_exception();
+  v.resize(n);
+  f.read_chars((char*) v.data(), sizeof(T) * v.size());
+  }
+
+/** call shape for an hpcshape member of geometry_information, or for every hpcshape in an array member */
+template<class F> void walk_shape_member(hpcshape& sh, const F& shape) { shape(sh); }
+template<class T, size_t N, class F> void walk_shape_member(T (&a)[N], const F& shape) { for(auto& x: a) walk_shape_member(x, shape); }
+template<class T, size_t N, class F> void walk_shape_member(array<T, N>& a, const F& shape) { for(auto& x: a) walk_shape_member(x, shape); }
+
+template<class F, class... T> void walk_shape_members(const F& shape, T&... members) {
+  int dummy[] = {0, (walk_shape_member(members, shape), 0)...};
+  ignore(dummy);
+  }
+
+/** visit all the hpcshapes computed by prepare_shapes, in a fixed order; `sized` is called with the size of every vector before its elements are visited, and may change it */
+template<class S, class F> void walk_cached_shapes(geometry_information& g, const S& sized, const F& shape) {
+  auto vec = [&] (vector<hpcshape>& v) {
+    int n = isize(v); sized(n); v.resize(n);
+    for(auto& sh: v) shape(sh);
+    };
+  /* the hpcshape members of geometry_information, from shSemiFloorSide to shReserved, in their declaration order;
+   * a member missing here is caught by save_shape_cache, which refuses to save when allshapes has a shape it has not visited */
+  walk_shape_members(shape,
+    g.shSemiFloorSide, g.shBFloor, g.shWave, g.shCircleFloor, g.shBarrel, g.shWall, g.shMineMark, g.shBigMineMark,
+    g.shFan, g.shZebra, g.shSwitchDisk, g.shTower, g.shEmeraldFloor, g.shSemiFeatherFloor, g.shSemiFloor,
+    g.shSemiBFloor, g.shSemiFloorShadow, g.shMercuryBridge, g.shTriheptaSpecial, g.shCross, g.shGiantStar, g.shLake,
+    g.shMirror, g.shHalfFloor, g.shHalfMirror, g.shGem, g.shStar, g.shFlash, g.shDisk, g.shHalfDisk, g.shDiskT,
+    g.shDiskS, g.shDiskM, g.shDiskSq, g.shEccentricDisk, g.shDiskSegment, g.shHeptagon, g.shHeptagram, g.shTinyBird,
+    g.shTinyShark, g.shEgg, g.shSmallEgg, g.shRing, g.shSpikedRing, g.shTargetRing, g.shSawRing, g.shGearRing,
+    g.shPeaceRing, g.shHeptaRing, g.shSpearRing, g.shLoveRing, g.shFrogRing, g.shPowerGearRing, g.shProtectiveRing,
+    g.shTerraRing, g.shMoveRing, g.shReserved4, g.shMoonDisk, g.shDaisy, g.shSnowflake, g.shTriangle, g.shNecro,
+    g.shStatue, g.shKey, g.shWindArrow, g.shGun, g.shFigurine, g.shTreat, g.shSmallTreat, g.shElementalShard,
+    g.shILeaf, g.shMovestar, g.shWolf, g.shYeti, g.shDemon, g.shGDemon, g.shEagle, g.shGargoyleWings,
+    g.shGargoyleBody, g.shFoxTail1, g.shFoxTail2, g.shDogBody, g.shDogHead, g.shDogFrontLeg, g.shDogRearLeg,
+    g.shDogFrontPaw, g.shDogRearPaw, g.shDogTorso, g.shHawk, g.shCatBody, g.shCatLegs, g.shCatHead, g.shFamiliarHead,
+    g.shFamiliarEye, g.shWolf1, g.shWolf2, g.shWolf3, g.shRatEye1, g.shRatEye2, g.shRatEye3, g.shDogStripes,
+    g.shPBody, g.shSmallPBody, g.shPSword, g.shSmallPSword, g.shPKnife, g.shFerocityM, g.shFerocityF, g.shHumanFoot,
+    g.shHumanLeg, g.shHumanGroin, g.shHumanNeck, g.shSkeletalFoot, g.shYetiFoot, g.shMagicSword, g.shSmallSword,
+    g.shMagicShovel, g.shSeaTentacle, g.shKrakenHead, g.shKrakenEye, g.shKrakenEye2, g.shArrow, g.shPHead, g.shPFace,
+    g.shGolemhead, g.shHood, g.shArmor, g.shAztecHead, g.shAztecCap, g.shSabre, g.shTurban1, g.shTurban2,
+    g.shVikingHelmet, g.shRaiderHelmet, g.shRaiderArmor, g.shRaiderBody, g.shRaiderShirt, g.shWestHat1, g.shWestHat2,
+    g.shGunInHand, g.shKnightArmor, g.shKnightCloak, g.shWightCloak, g.shGhost, g.shEyes, g.shSlime, g.shJelly,
+    g.shJoint, g.shWormHead, g.shSmallWormHead, g.shTentHead, g.shShark, g.shWormSegment, g.shSmallWormSegment,
+    g.shWormTail, g.shSmallWormTail, g.shSlimeEyes, g.shDragonEyes, g.shSmallDragonEyes, g.shWormEyes,
+    g.shSmallWormEyes, g.shGhostEyes, g.shMiniGhost, g.shSmallEyes, g.shMiniEyes, g.shHedgehogBlade,
+    g.shSmallHedgehogBlade, g.shHedgehogBladePlayer, g.shWolfBody, g.shWolfHead, g.shWolfLegs, g.shWolfEyes,
+    g.shWolfFrontLeg, g.shWolfRearLeg, g.shWolfFrontPaw, g.shWolfRearPaw, g.shFemaleBody, g.shFemaleHair,
+    g.shFemaleDress, g.shWitchDress, g.shWitchHair, g.shBeautyHair, g.shFlowerHair, g.shFlowerHand, g.shSuspenders,
+    g.shTrophy, g.shBugBody, g.shBugArmor, g.shBugLeg, g.shBugAntenna, g.shPickAxe, g.shSmallPickAxe, g.shPike,
+    g.shFlailBall, g.shSmallFlailBall, g.shFlailTrunk, g.shSmallFlailTrunk, g.shFlailChain, g.shHammerHead,
+    g.shSmallHammerHead, g.shBook, g.shBookCover, g.shGrail, g.shBoatOuter, g.shBoatInner, g.shCompass1,
+    g.shCompass2, g.shCompass3, g.shKnife, g.shTongue, g.shFlailMissile, g.shTrapArrow, g.shPirateHook,
+    g.shSmallPirateHook, g.shPirateHood, g.shEyepatch, g.shPirateX, g.shHeptaMarker, g.shSnowball, g.shHugeDisk,
+    g.shSkyboxSun, g.shSun, g.shNightStar, g.shEuclideanSky, g.shSkeletonBody, g.shSkull, g.shSkullEyes, g.shFatBody,
+    g.shWaterElemental, g.shPalaceGate, g.shFishTail, g.shMouse, g.shMouseLegs, g.shMouseEyes, g.shPrincessDress,
+    g.shPrinceDress, g.shWizardCape1, g.shWizardCape2, g.shBigCarpet1, g.shBigCarpet2, g.shBigCarpet3, g.shGoatHead,
+    g.shRose, g.shRoseItem, g.shSmallRose, g.shThorns, g.shRatHead, g.shRatTail, g.shRatEyes, g.shRatCape1,
+    g.shRatCape2, g.shWizardHat1, g.shWizardHat2, g.shTortoise, g.shDragonLegs, g.shDragonTail, g.shDragonHead,
+    g.shSmallDragonHead, g.shDragonSegment, g.shDragonNostril, g.shSmallDragonNostril, g.shDragonWings,
+    g.shSolidBranch, g.shWeakBranch, g.shBead0, g.shBead1, g.shBatWings, g.shBatBody, g.shBatMouth, g.shBatFang,
+    g.shBatEye, g.shParticle, g.shAsteroid, g.shReptile, g.shReptileBody, g.shReptileHead, g.shReptileFrontFoot,
+    g.shReptileRearFoot, g.shReptileFrontLeg, g.shReptileRearLeg, g.shReptileTail, g.shReptileEye, g.shTrylobite,
+    g.shTrylobiteHead, g.shTrylobiteBody, g.shTrylobiteFrontLeg, g.shTrylobiteRearLeg, g.shTrylobiteFrontClaw,
+    g.shTrylobiteRearClaw, g.shBullBody, g.shBullHead, g.shBullHorn, g.shBullRearHoof, g.shBullFrontHoof,
+    g.shSmallBullHead, g.shSmallBullHorn, g.shTinyBullHead, g.shTinyBullHorn, g.shTinyBullBody, g.shButterflyBody,
+    g.shButterflyWing, g.shGadflyBody, g.shGadflyWing, g.shGadflyEye, g.shTerraArmor1, g.shTerraArmor2,
+    g.shTerraArmor3, g.shTerraHead, g.shTerraFace, g.shJiangShi, g.shJiangShiDress, g.shJiangShiCap1,
+    g.shJiangShiCap2, g.shPikeBody, g.shPikeEye, g.shAsymmetric, g.shPBodyOnly, g.shPBodyArm, g.shPBodyHand,
+    g.shPHeadOnly, g.shDodeca, g.shSmallerDodeca, g.shLightningBolt, g.shHumanoid, g.shHalfHumanoid, g.shHourglass,
+    g.shShield, g.shSmallFan, g.shTreeIcon, g.shLeafIcon, g.shFrogRearFoot, g.shFrogFrontFoot, g.shFrogRearLeg,
+    g.shFrogFrontLeg, g.shFrogRearLeg2, g.shFrogBody, g.shFrogEye, g.shFrogStripe, g.shFrogJumpFoot, g.shFrogJumpLeg,
+    g.shSmallFrogRearFoot, g.shSmallFrogFrontFoot, g.shSmallFrogRearLeg, g.shSmallFrogFrontLeg,
+    g.shSmallFrogRearLeg2, g.shSmallFrogBody, g.shAnimatedEagle, g.shAnimatedTinyEagle, g.shAnimatedGadfly,
+    g.shAnimatedHawk, g.shAnimatedButterfly, g.shAnimatedGargoyle, g.shAnimatedGargoyle2, g.shAnimatedBat,
+    g.shAnimatedBat2, g.shTinyArrow, g.shCrossbow, g.shCrossbowBolt, g.shCrossbowstringLoaded,
+    g.shCrossbowstringUnloaded, g.shCrossbowstringSemiloaded, g.shCrossbowIcon, g.shCrossbowstringIcon,
+    g.shSpaceship, g.shMissile, g.shSpaceshipBase, g.shSpaceshipCockpit, g.shSpaceshipGun, g.shSpaceshipEngine,
+    g.shChristmasLight, g.shSmallPike, g.shBunnyBody, g.shBunnyHead, g.shBunnyEar, g.shBunnyTail, g.shReserved);
+  for(auto& sh: g.shFullCross) shape(sh);
+  shape(g.lash_default.shIBranch);
+  vec(g.shPlainWall3D); vec(g.shWireframe3D); vec(g.shWall3D); vec(g.shMiniWall3D);
+  auto floorshape_tables = [&] (floorshape& fsh) {
+    vec(fsh.b); vec(fsh.shadow); vec(fsh.cone[0]); vec(fsh.cone[1]);
+    for(auto& v: fsh.levels) vec(v);
+    for(auto& v: fsh.side) {
+      int n = isize(v); sized(n); v.resize(n);
+      for(auto& v1: v) vec(v1);
+      }
+    };
+  for(auto fsh: g.all_plain_floorshapes) floorshape_tables(*fsh);
+  for(auto fsh: g.all_escher_floorshapes) floorshape_tables(*fsh);
+  }
+
+/** the parameters the cached shapes depend on, but which are not necessarily in cgi_string */
+vector<ld> shape_cache_fingerprint(geometry_information& g) {
+  return {
+    g.scalefactor, g.crossf, g.hexf, g.hcrossf, g.tessf, g.hexvdist, g.rhexf, g.floorrad0, g.floorrad1,
+    g.FLOOR, g.WALL, g.human_height, ld(S3), ld(S7), ld(WDIM), ld(GDIM),
+    ld(vid.texture_step), ld(vid.linequality), ld(noGUI), ld(floorshapes_level), ld(floor_textures != nullptr), ld(CAP_GL)
+    };
+  }
+
+void shape_cache_header(hstream& f, const string& key) {
+  f.write<string>("HyperRogue shapes " VER);
+  for(int i: {SHAPE_CACHE_VERSION, int(sizeof(ld)), int(sizeof(hyperpoint)), int(sizeof(hpcshape)), SIDEPARS, MAXMDIM})
+    f.write<int>(i);
+  f.write<string>(key);
+  }
+
+void geometry_information::save_shape_cache(const string& fname, const string& key) {
+  if(!shPipe.empty() || !lash.empty()) return;
+  map<hpcshape*, int> index;
+  walk_cached_shapes(*this, [] (int& n) {}, [&] (hpcshape& sh) { index.emplace(&sh, isize(index)); });
+  for(auto sh: allshapes) if(!index.count(sh)) {
+    if(debug_shape_cache) println(hlog, "shape cache: unknown shape, not saving");
+    return;
+    }
+  for(auto& p: walloffsets) if(p.second) return;
+
+  if(!file_exists(shape_cache_dir)) hr::ignore(system(("mkdir -p \"" + shape_cache_dir + "\"").c_str()));
+  string tmp = fname + ".tmp";
+  try {
+    fhstream f(tmp, "wb");
+    if(!f.f) throw hstream_exception("cannot create " + tmp);
+    shape_cache_header(f, key);
+    hwrite_block(f, shape_cache_fingerprint(*this));
+
+    auto tinf_code = [&] (basic_textureinfo *t) {
+      if(!t) return -1;
+      if(t == &models_texture) return -2;
+      for(int i=0; i<isize(floor_texture_vertices); i++) if(t == &floor_texture_vertices[i]) return i;
+      throw hstream_exception("unknown texture");
+      };
+    walk_cached_shapes(*this, [&] (int& n) { f.write<int>(n); }, [&] (hpcshape& sh) {
+      for(int i: {sh.s, sh.e, int(sh.prio), sh.flags, tinf_code(sh.tinf), sh.texture_offset, sh.shs, sh.she}) f.write<int>(i);
+      hwrite_raw(f, sh.intester);
+      });
+    f.write<int>(isize(allshapes));
+    for(auto sh: allshapes) f.write<int>(index[sh]);
+
+    hwrite_block(f, hpc);
+    hwrite_block(f, symmetriesAt);
+    f.write<int>(isize(walloffsets));
+    for(auto& p: walloffsets) f.write<int>(p.first);
+    hwrite_block(f, wallstart);
+    hwrite_block(f, walltester);
+    hwrite_block(f, raywall);
+    hwrite_block(f, angle_of_zero);
+    hwrite_block(f, models_texture.tvertices);
+    hwrite_block(f, models_texture.colors);
+    for(int i: {SD3, SD6, SD7, S12, S14, S21, S28, S42, S36, S84, orb_inner_ring}) f.write<int>(i);
+    for(ld x: {S_step, wormscale, tentacle_length, sword_size, corner_bonus, eyelevel_human, eyelevel_dog, eyelevel_familiar}) hwrite_raw(f, x);
+    hwrite_raw(f, asteroid_size);
+    hwrite_raw(f, dlow_table); hwrite_raw(f, dhi_table); hwrite_raw(f, validsidepar);
+    hwrite_raw(f, shadowmulmatrix);
+    #if MAXMDIM >= 4
+    for(auto& T: {front_leg_move, front_leg_move_inverse, rear_leg_move, rear_leg_move_inverse}) hwrite_raw(f, T);
+    hwrite_raw(f, leg_length);
+    #endif
+    f.write<string>("end");
+    }
+  catch(hstream_exception& e) {
+    if(debug_shape_cache) println(hlog, "shape cache: could not save ", fname, ": ", e.what());
+    remove(tmp.c_str());
+    return;
+    }
+  rename(tmp.c_str(), fname.c_str());
+  }
+
+bool geometry_information::load_shape_cache(const string& fname, const string& key) {
+  string buf;
+  const char *data = nullptr;
+  size_t size = 0;
+  #if CAP_MMAP
+  void *mapping = nullptr;
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if(fd == -1) return false;
+  struct stat st;
+  if(fstat(fd, &st) == 0 && st.st_size > 0) {
+    mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(mapping == MAP_FAILED) mapping = nullptr;
+    else data = (const char*) mapping, size = st.st_size;
+    }
+  ::close(fd);
+  if(!mapping) return false;
+  #else
+  FILE *ff = fopen(fname.c_str(), "rb");
+  if(!ff) return false;
+  char chunk[65536];
+  while(true) {
+    size_t q = fread(chunk, 1, sizeof(chunk), ff);
+    if(!q) break;
+    buf.append(chunk, q);
+    }
+  fclose(ff);
+  data = buf.data(); size = buf.size();
+  #endif
+
+  bool ok = false;
+  bool started = false;
+  try {
+    memory_hstream f(data, size);
+    shstream expected;
+    shape_cache_header(expected, key);
+    string header(data, min(size, expected.s.size()));
+    if(header != expected.s) throw hstream_exception("header mismatch");
+    f.p += header.size();
+    vector<ld> fp;
+    hread_block(f, fp);
+    if(fp != shape_cache_fingerprint(*this)) throw hstream_exception("fingerprint mismatch");
+
+    started = true;
+    vector<hpcshape*> order;
+    walk_cached_shapes(*this, [&] (int& n) { n = f.get<int>(); if(n < 0 || n > (1<<24)) throw hstream_exception(); }, [&] (hpcshape& sh) {
+      int v[8];
+      for(int& i: v) i = f.get<int>();
+      sh.s = v[0]; sh.e = v[1]; sh.prio = PPR(v[2]); sh.flags = v[3];
+      if(v[4] >= isize(floor_texture_vertices) || v[4] < -2) throw hstream_exception("bad texture");
+      sh.tinf = v[4] == -1 ? nullptr : v[4] == -2 ? &models_texture : &floor_texture_vertices[v[4]];
+      sh.texture_offset = v[5]; sh.shs = v[6]; sh.she = v[7];
+      hread_raw(f, sh.intester);
+      order.push_back(&sh);
+      });
+    allshapes.resize(f.get<int>());
+    for(auto& sh: allshapes) {
+      int i = f.get<int>();
+      if(i < 0 || i >= isize(order)) throw hstream_exception();
+      sh = order[i];
+      }
+
+    hread_block(f, hpc);
+    hread_block(f, symmetriesAt);
+    walloffsets.resize(f.get<int>());
+    for(auto& p: walloffsets) p = {f.get<int>(), nullptr};
+    hread_block(f, wallstart);
+    hread_block(f, walltester);
+    hread_block(f, raywall);
+    hread_block(f, angle_of_zero);
+    hread_block(f, models_texture.tvertices);
+    hread_block(f, models_texture.colors);
+    for(int* i: {&SD3, &SD6, &SD7, &S12, &S14, &S21, &S28, &S42, &S36, &S84, &orb_inner_ring}) *i = f.get<int>();
+    for(ld* x: {&S_step, &wormscale, &tentacle_length, &sword_size, &corner_bonus, &eyelevel_human, &eyelevel_dog, &eyelevel_familiar}) hread_raw(f, *x);
+    hread_raw(f, asteroid_size);
+    hread_raw(f, dlow_table); hread_raw(f, dhi_table); hread_raw(f, validsidepar);
+    hread_raw(f, shadowmulmatrix);
+    #if MAXMDIM >= 4
+    for(auto T: {&front_leg_move, &front_leg_move_inverse, &rear_leg_move, &rear_leg_move_inverse}) hread_raw(f, *T);
+    hread_raw(f, leg_length);
+    #endif
+    if(f.get<string>() != "end") throw hstream_exception("bad ending");
+    ok = true;
+    }
+  catch(hstream_exception& e) {
+    if(debug_shape_cache) println(hlog, "shape cache: could not use ", fname, ": ", e.what());
+    }
+
+  #if CAP_MMAP
+  munmap(mapping, size);
+  #endif
+
+  if(!ok) {
+    if(started) {
+      walk_cached_shapes(*this, [] (int& n) { n = 0; }, [] (hpcshape& sh) { sh.clear(); });
+      hpc.clear(); allshapes.clear(); symmetriesAt.clear();
+      walloffsets.clear(); wallstart.clear(); walltester.clear(); raywall.clear(); angle_of_zero.clear();
+      models_texture.tvertices.clear(); models_texture.colors.clear();
+      }
+    return false;
+    }
+
+  #if MAXMDIM >= 4
+  if(GDIM == 3 && !noGUI) {
+    eyepos = WDIM == 2 ? 0.875 : 0.925;
+    #if CAP_GL
+    if(floor_textures) models_texture.texture_id = floor_textures->renderedTexture;
+    #endif
+    }
+  #endif
+  return true;
+  }
+
+auto ah_shape_cache = arg::add2("-shape-cache", [] { shape_cache_dir = user_cache_dir(); })
+  + arg::add2("-shape-cache-dir", [] { arg::shift(); shape_cache_dir = arg::args(); });
+
 void geometry_information::prepare_shapes() {
   require_basics();
   if(cgflags & qRAYONLY) return;
@@ -1185,8 +1513,25 @@ void geometry_information::prepare_shapes() {
 
   if(fake::in()) { FPIU( cgi.require_shapes() ); }
 
+  int t0 = SDL_GetTicks();
+  string key;
+  string cache_file = shape_cache_file(key);
+
   symmetriesAt.clear();
   allshapes.clear();
+
+  if(cache_file != "") {
+    hpc.clear(); ext.clear();
+    configure_floorshapes();
+    if(load_shape_cache(cache_file, key)) {
+      finishshape();
+      prehpc = isize(hpc);
+      initPolyForGL();
+      if(debug_shape_cache) println(hlog, "shapes loaded from ", cache_file, " in ", SDL_GetTicks() - t0, " ms");
+      return;
+      }
+    }
+
   DEBBI(debug_poly, ("buildpolys"));
 
   if(WDIM == 3 && !mhybrid) {
@@ -1721,6 +2066,9 @@ void geometry_information::prepare_shapes() {
   prehpc = isize(hpc);
 
   initPolyForGL();
+
+  if(debug_shape_cache) println(hlog, "shapes computed in ", SDL_GetTicks() - t0, " ms");
+  if(cache_file != "") save_shape_cache(cache_file, key);
   }
 
 EX vector<long double> polydata = {
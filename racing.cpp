@@ -105,12 +105,86 @@ void hwrite(hstream& hs, const ghost& gh) {
   hwrite(hs, gh.cs, gh.result, gh.timestamp, gh.checksum, gh.history);
   }
 
+/* the compact ghost format: the moments are delta-encoded, with the step and cell id deltas stored as zigzag varints */
+
+/** \brief the first version which saves the ghosts in the compact format */
+static constexpr int compact_ghosts_version = 0xAA2D;
+
+/** \brief starts the compact ghosts; only a sanity check, the format is given by the version */
+static constexpr int compact_ghosts_marker = -2;
+
+void write_varint(hstream& hs, unsigned x) {
+  while(x >= 128) { hs.write_char(char(x | 128)); x >>= 7; }
+  hs.write_char(char(x));
+  }
+
+unsigned read_varint(hstream& hs) {
+  unsigned x = 0;
+  for(int s=0; s<35; s+=7) {
+    unsigned char c = hs.read_char();
+    x |= unsigned(c & 127) << s;
+    if(!(c & 128)) return x;
+    }
+  throw hstream_exception("bad varint in a ghost");
+  }
+
+unsigned zigzag(int x) { return (unsigned(x) << 1) ^ unsigned(x >> 31); }
+int unzigzag(unsigned x) { return int(x >> 1) ^ -int(x & 1); }
+
+void write_compact(hstream& hs, const ghost& gh) {
+  hwrite(hs, gh.cs, gh.result, gh.timestamp, gh.checksum);
+  hs.write<int>(isize(gh.history));
+  ghostmoment prev{0, nullptr, 0, 0, 0, 0};
+  int previd = 0;
+  for(auto& m: gh.history) {
+    int id = mapstream::cellids[m.where_cell];
+    write_varint(hs, zigzag(m.step - prev.step));
+    write_varint(hs, zigzag(id - previd));
+    hs.write_char(m.alpha - prev.alpha);
+    hs.write_char(m.distance - prev.distance);
+    hs.write_char(m.beta - prev.beta);
+    hs.write_char(m.footphase - prev.footphase);
+    prev = m; previd = id;
+    }
+  }
+
+void read_compact(hstream& hs, ghost& gh) {
+  hread(hs, gh.cs, gh.result, gh.timestamp, gh.checksum);
+  int n = hs.get<int>();
+  if(n < 0) throw hstream_exception("bad ghost length");
+  gh.history.clear();
+  gh.history.reserve(n);
+  ghostmoment prev{0, nullptr, 0, 0, 0, 0};
+  int previd = 0;
+  for(int i=0; i<n; i++) {
+    ghostmoment m;
+    m.step = prev.step + unzigzag(read_varint(hs));
+    int id = previd + unzigzag(read_varint(hs));
+    if(id < 0 || id >= isize(mapstream::cellbyid)) throw hr_exception("error reading a ghost moment");
+    m.where_cell = mapstream::cellbyid[id];
+    m.alpha = prev.alpha + hs.read_char();
+    m.distance = prev.distance + hs.read_char();
+    m.beta = prev.beta + hs.read_char();
+    m.footphase = prev.footphase + hs.read_char();
+    gh.history.push_back(m);
+    prev = m; previd = id;
+    }
+  }
+
 EX void save_ghosts(hstream& f) {
-  hwrite(f, ghostset);
+  if(f.vernum < compact_ghosts_version) { hwrite(f, ghostset); return; }
+  f.write<int>(compact_ghosts_marker);
+  f.write<int>(isize(ghostset));
+  for(auto& gh: ghostset) write_compact(f, gh);
   }
 
 EX void load_ghosts(hstream& f) {
-  hread(f, ghostset);
+  if(f.vernum < compact_ghosts_version) { hread(f, ghostset); return; }
+  if(f.get<int>() != compact_ghosts_marker) throw hstream_exception("bad compact ghosts marker");
+  int n = f.get<int>();
+  if(n < 0) throw hstream_exception("bad number of ghosts");
+  ghostset.resize(n);
+  for(auto& gh: ghostset) read_compact(f, gh);
   }
 
 #endif
@@ -1337,13 +1411,17 @@ void draw_ghost_at(ghost& ghost, cell *w, const shiftmatrix& V, ghostmoment& p)
   drawMonsterType(moPlayer, w, V, 0, uchar_to_frac(p.footphase), NOCOLOR);
   }
 
+/** \brief the first moment of the ghost after the current time; the history is ordered by step, so we can use binary search */
+vector<ghostmoment>::iterator ghost_position(ghost& ghost) {
+  return std::upper_bound(ghost.history.begin(), ghost.history.end(), ticks - race_start_tick, [] (int t, const ghostmoment& gm) { return t < gm.step; });
+  }
+
 bool ghost_finished(ghost& ghost) {
-  auto p = std::find_if(ghost.history.begin(), ghost.history.end(), [] (const ghostmoment gm) { return gm.step > ticks - race_start_tick;} );
-  return p == ghost.history.end();
+  return ghost_position(ghost) == ghost.history.end();
   }
 
 ghostmoment& get_ghostmoment(ghost& ghost) {
-  auto p = std::find_if(ghost.history.begin(), ghost.history.end(), [] (const ghostmoment gm) { return gm.step > ticks - race_start_tick;} );
+  auto p = ghost_position(ghost);
   if(p == ghost.history.end()) p--, p->footphase = 0;
   return *p;
   }
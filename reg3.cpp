@@ -1834,7 +1834,14 @@ EX namespace reg3 {
 
     void load_ruleset_new(string fname) {
 
-      shstream ins(decompress_string(read_file_as_string(fname)));
+      #if ISANDROID || ISIOS
+      shstream f(get_asset(fname));
+      #else
+      fhstream f(fname, "rb");
+      if(!f.f) f.f = fopen((rsrcdir + fname).c_str(), "rb");
+      if(!f.f) throw hstream_exception("cannot open ruleset " + fname);
+      #endif
+      zlib_input_hstream ins(f);
       ins.read(ins.vernum);
       if(1) {
         dynamicval<eVariation> dv(variation);
@@ -156,6 +156,10 @@ int dhrgArgs() {
     shift(); penalty = argf();
     }
 
+  else if(argis("-dhrg-batch")) {
+    shift(); move_batch = argi();
+    }
+
   else return 1;
 
   return 0;
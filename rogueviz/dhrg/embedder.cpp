@@ -23,6 +23,11 @@ ld penalty = 0;
 
 int lastmoves;
 
+/** the penalty for placing a vertex at the given level */
+ld level_penalty(int lev) {
+  return penalty ? log_descendants[lev] * penalty : 0;
+  }
+
 int movearound() {
   indenter_finish im("movearound");
   int N = get_n();
@@ -32,7 +37,8 @@ int movearound() {
     tomove.resize(0), tomove.resize(N, true);
     }
   int moves = 0;
-  ld llo = loglik_chosen();
+  prepare_log_descendants();
+  vertex_tally from, cand, best;
 //  int im = 0;
   
   {progressbar pb(N, "tomove: " + its(total) + " (last: " + its(lastmoves) + ")");
@@ -41,47 +47,29 @@ int movearound() {
     tomove[i] = false;
     // if(i && i % 100 == 0) dispnewmoves();
     mycell *mc = vertices[i];
-    tallyedgesof(i, -1, mc);
     add_to_set(mc, -1, 0);
-    add_to_tally(mc, -1, 0);
+    tally_vertex(i, mc, from);
 //    im += size(rogueviz::vdata[i].edges);
-    mycell *mc2[FULL_EDGE];
-    ld llo2[FULL_EDGE];
-    int bestd = -1;
-    ld bestllo = llo;
+    ld bestchange = 0;
     
     auto nei = allneighbors(mc);
     
     for(int d=0; d<isize(nei); d++) {
-      mc2[d] = nei[d];
-      if(mc2[d]->lev >= distlimit) continue;
-      tallyedgesof(i, 1, mc2[d]);
-      add_to_tally(mc2[d], 1, 0);
-      if(lc_type == 'C')
-        add_to_set(mc2[d], 1, 0);
-      llo2[d] = loglik_chosen();
-      if(lc_type == 'C')
-        add_to_set(mc2[d], -1, 0);
-      ld with_penalty = llo2[d];
-      if(penalty) with_penalty += cgi.expansion->get_descendants(mc->lev).log_approx() * penalty;
-      if(penalty) with_penalty -= cgi.expansion->get_descendants(mc2[d]->lev).log_approx() * penalty;
-      if(with_penalty > bestllo) bestd = d, bestllo = with_penalty;
-      
-      add_to_tally(mc2[d], -1, 0);
-      tallyedgesof(i, -1, mc2[d]);
+      if(nei[d]->lev >= distlimit) continue;
+      tally_vertex(i, nei[d], cand);
+      ld with_penalty = loglik_change(from, cand) + level_penalty(mc->lev) - level_penalty(nei[d]->lev);
+      if(with_penalty > bestchange) bestchange = with_penalty, best = cand;
       }
-    if(bestd >= 0) {
+    if(bestchange > 0) {
       moves++; newmoves++;
-      vertices[i] = mc = mc2[bestd];
-      llo = llo2[bestd];
+      apply_vertex_move(from, best);
+      vertices[i] = mc = best.where;
       tomove[i] = true;
       for(auto p: rogueviz::vdata[i].edges) {
         int j = p.second->i ^ p.second->j ^ i;
         tomove[j] = true;
         }
       }
-    tallyedgesof(i, 1, mc);
-    add_to_tally(mc, 1, 0);
     add_to_set(mc, 1, 0);
     pb++;
     }}
@@ -91,6 +79,120 @@ int movearound() {
   return lastmoves = moves;
   }
 
+/** the number of vertices whose moves are evaluated together in movearound_parallel; 0 = use movearound */
+int move_batch = 0;
+
+/** like movearound, but the best moves of a batch of pairwise non-adjacent vertices are found in parallel. The
+ *  candidates are scored without the other vertices of the batch; every move is then checked exactly and applied
+ *  serially, so the loglikelihood never decreases */
+int movearound_parallel() {
+  indenter_finish im("movearound_parallel");
+  int N = get_n();
+  int total = 0;
+  if(smartmove) for(bool b: tomove) if(b) total++;
+  if(total == 0) {
+    tomove.resize(0), tomove.resize(N, true);
+    }
+  int moves = 0;
+  prepare_log_descendants();
+
+  vector<int> queue;
+  for(int i=0; i<N; i++) if(tomove[i]) queue.push_back(i);
+
+  vector<int> batch_stamp(N, -1);
+  int stamp = 0;
+
+  vector<int> batch;
+  vector<vector<mycell*>> candidates;
+  vector<int> proposal;
+  vertex_tally from, to;
+
+  progressbar pb(isize(queue), "tomove: " + its(isize(queue)) + " (last: " + its(lastmoves) + ") in parallel");
+
+  while(!queue.empty()) {
+    /* choose the batch: vertices which are not neighbors of each other; the others wait for the next batch */
+    batch.clear();
+    vector<int> deferred;
+    int qi = 0;
+    for(; qi < isize(queue) && isize(batch) < move_batch; qi++) {
+      int i = queue[qi];
+      if(batch_stamp[i] == stamp) { deferred.push_back(i); continue; }
+      batch.push_back(i);
+      batch_stamp[i] = stamp;
+      for(auto p: rogueviz::vdata[i].edges) batch_stamp[p.second->i ^ p.second->j ^ i] = stamp;
+      }
+    for(; qi < isize(queue); qi++) deferred.push_back(queue[qi]);
+    queue = std::move(deferred);
+    stamp++;
+
+    int B = isize(batch);
+    candidates.resize(B);
+    proposal.assign(B, -1);
+
+    /* remove the batch from the set, and build everything that tally_vertex will need */
+    for(int k=0; k<B; k++) {
+      int i = batch[k];
+      tomove[i] = false;
+      mycell *mc = vertices[i];
+      add_to_set(mc, -1, 0);
+      auto& cands = candidates[k];
+      cands = {mc};
+      for(auto m: allneighbors(mc)) if(m->lev < distlimit) cands.push_back(m);
+      }
+    /* a probe may create segments which change what the earlier probes would do, so repeat until nothing new appears */
+    while(true) {
+      auto created = segmentcount + mycellcount + cellcount;
+      for(int k=0; k<B; k++) for(auto m: candidates[k]) probe_vertex_tally(batch[k], m);
+      if(created == segmentcount + mycellcount + cellcount) break;
+      }
+
+    rogueviz::embeddings::embeddings_for(B, [&] (int a, int b) {
+      std::unordered_map<segment*, int> seen;
+      dynamicval<std::unordered_map<segment*, int>*> as(ack_seen, &seen);
+      vertex_tally from, cand;
+      for(int k=a; k<b; k++) {
+        int i = batch[k];
+        auto& cands = candidates[k];
+        tally_vertex(i, cands[0], from);
+        ld bestchange = 0;
+        for(int d=1; d<isize(cands); d++) {
+          tally_vertex(i, cands[d], cand);
+          ld with_penalty = loglik_change(from, cand) + level_penalty(cands[0]->lev) - level_penalty(cands[d]->lev);
+          if(with_penalty > bestchange) bestchange = with_penalty, proposal[k] = d;
+          }
+        }
+      });
+
+    /* put the batch back, and apply the moves which are still good */
+    for(int k=0; k<B; k++) add_to_set(vertices[batch[k]], 1, 0);
+    for(int k=0; k<B; k++) {
+      pb++;
+      if(proposal[k] < 0) continue;
+      int i = batch[k];
+      mycell *mc = vertices[i];
+      mycell *mc2 = candidates[k][proposal[k]];
+      add_to_set(mc, -1, 0);
+      tally_vertex(i, mc, from);
+      tally_vertex(i, mc2, to);
+      if(loglik_change(from, to) + level_penalty(mc->lev) - level_penalty(mc2->lev) > 0) {
+        moves++; newmoves++;
+        apply_vertex_move(from, to);
+        vertices[i] = mc = mc2;
+        tomove[i] = true;
+        for(auto p: rogueviz::vdata[i].edges) {
+          int j = p.second->i ^ p.second->j ^ i;
+          tomove[j] = true;
+          }
+        }
+      add_to_set(mc, 1, 0);
+      }
+    }
+
+  println(hlog, " moves = ", moves);
+  if(penalty) println(hlog, "penalty = ", penalty);
+  return lastmoves = moves;
+  }
+
 int move_restart() {
   indenter_finish im("move_restart");
   ld llo = loglik_chosen();
@@ -279,7 +381,7 @@ void graph_from_rv() {
 bool iteration() {
   iterations++;
   indenter_finish im("Iteration #" + its(iterations));
-  int m = movearound();
+  int m = move_batch ? movearound_parallel() : movearound();
   if(!m && dorestart) m = move_restart();
   if(!m) return false;
   fix_logistic_parameters(current_logistic, loglik_logistic, "logistic", 1e-6);
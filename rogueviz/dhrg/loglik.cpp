@@ -5,7 +5,7 @@ namespace dhrg {
 // tally edges of the given vertex at the given index
 
 int edgetally[MAXDIST];
-int *whichedgetally = edgetally;
+thread_local int *whichedgetally = edgetally;
 
 void tallyedgesof(int i, int delta, mycell *mc) {
   using namespace rogueviz;
@@ -98,7 +98,7 @@ ld loglikopt() {
 
 // --- optimal monotonic loglikelihood
 
-ld loglikopt_mono() {
+ld loglikopt_mono(const ll *tally, const int *edgetally) {
   vector<pair<ld, ld> > pairs;
   ld result = 0;
   for(int u=0; u<MAXDIST; u++) {
@@ -117,6 +117,8 @@ ld loglikopt_mono() {
   return result;
   }
 
+ld loglikopt_mono() { return loglikopt_mono(tally, edgetally); }
+
 // --- compute loglikelihood according to current method
 
 char lc_type = 'R';
@@ -138,6 +140,110 @@ ld loglik_chosen() {
     }
   }
 
+// --- change of the loglikelihood caused by moving a single vertex
+// (computed from the tallies of that vertex only, without changing the global tallies)
+
+/** the distances from a vertex, placed in some cell, to all the other vertices in the set, and to its neighbors */
+struct vertex_tally {
+  mycell *where;
+  ll pairs[MAXDIST];
+  int edges[MAXDIST];
+  };
+
+/** compute the vertex_tally of vertex i placed at mc; i should not be in the set. Thread-safe if the structures
+ *  around mc have already been built (see probe_vertex_tally) */
+void tally_vertex(int i, mycell *mc, vertex_tally& vt) {
+  vt.where = mc;
+  for(int u=0; u<MAXDIST; u++) vt.pairs[u] = 0, vt.edges[u] = 0;
+  dynamicval<ll*> dt(whichtally, vt.pairs);
+  dynamicval<int*> det(whichedgetally, vt.edges);
+  add_to_tally(mc, 1, 0);
+  tallyedgesof(i, 1, mc);
+  }
+
+/** do everything tally_vertex would do to the shared structures (building cells and segments), but do not tally */
+void probe_vertex_tally(int i, mycell *mc) {
+  build_ack(mc, 0);
+  for(auto p: acknowledged) p->seen = -1;
+  acknowledged.clear();
+  for(auto p: rogueviz::vdata[i].edges) {
+    int j = p.second->i ^ p.second->j ^ i;
+    quickdist(mc, vertices[j], 0);
+    }
+  }
+
+/** log of the number of cells on each level, for the placement loglikelihood; get_descendants is not thread-safe, so computed in advance */
+vector<ld> log_descendants;
+
+void prepare_log_descendants() {
+  while(isize(log_descendants) < BOXSIZE)
+    log_descendants.push_back(cgi.expansion->get_descendants(isize(log_descendants)).log_approx());
+  }
+
+/** the change of loglik_chosen() when the vertex tallied in 'from' moves to 'to'; the global tallies include 'from',
+ *  and the vertex is not in the set */
+ld loglik_change(const vertex_tally& from, const vertex_tally& to) {
+  ld result = 0;
+
+  auto for_changes = [&] (const auto& f) {
+    for(int u=0; u<MAXDIST; u++) {
+      if(from.pairs[u] == to.pairs[u] && from.edges[u] == to.edges[u]) continue;
+      f(edgetally[u], tally[u], ld(edgetally[u] - from.edges[u] + to.edges[u]), ld(tally[u] - from.pairs[u] + to.pairs[u]), u);
+      }
+    };
+
+  auto full = [&] (const auto& f) {
+    ll t[MAXDIST]; int e[MAXDIST];
+    for(int u=0; u<MAXDIST; u++) t[u] = tally[u] - from.pairs[u] + to.pairs[u], e[u] = edgetally[u] - from.edges[u] + to.edges[u];
+    return f(t, e) - f(tally, edgetally);
+    };
+
+  auto opt = [&] {
+    for_changes([&] (ld e0, ld t0, ld e1, ld t1, int u) {
+      result += rogueviz::embeddings::bestll2(e1, t1) - rogueviz::embeddings::bestll2(e0, t0);
+      });
+    };
+
+  auto placement = [&] {
+    int l0 = from.where->lev, l1 = to.where->lev;
+    if(l0 == l1) return;
+    auto seg = getsegment(mroot, mroot, 0, false);
+    int N = get_n();
+    auto term = [&] (int q, int j) { return q ? q * (log(q*1./N) - log_descendants[j]) : 0; };
+    int q0 = seg ? seg->qty.qty[l0] : 0, q1 = seg ? seg->qty.qty[l1] : 0;
+    result += term(q0, l0) + term(q1+1, l1) - term(q0+1, l0) - term(q1, l1);
+    };
+
+  switch(lc_type) {
+    case 'R': {
+      auto& l = current_logistic;
+      auto term = [&] (ld e, ld t, int u) { return (e && t-e) ? e * l.lyes(u) + (t-e) * l.lno(u) : 0; };
+      for_changes([&] (ld e0, ld t0, ld e1, ld t1, int u) { result += term(e1, t1, u) - term(e0, t0, u); });
+      return result;
+      }
+    case 'M':
+      return full([] (const ll *t, const int *e) { return loglikopt_mono(t, e); });
+    case 'C':
+      opt(); placement();
+      return result;
+    case 'D':
+      result = full([] (const ll *t, const int *e) { return loglikopt_mono(t, e); });
+      placement();
+      return result;
+    default:
+      opt();
+      return result;
+    }
+  }
+
+/** apply the move described by loglik_change to the global tallies */
+void apply_vertex_move(const vertex_tally& from, const vertex_tally& to) {
+  for(int u=0; u<MAXDIST; u++) {
+    tally[u] += to.pairs[u] - from.pairs[u];
+    edgetally[u] += to.edges[u] - from.edges[u];
+    }
+  }
+
 // 1e-3 (cont), 1e-6 (normal)
 
 // statistics
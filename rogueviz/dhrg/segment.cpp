@@ -72,9 +72,18 @@ segment *getsegment(mycell *pleft, mycell *pright, int setid, bool docreate = tr
 
 ll tally[MAXDIST];
 
-ll *whichtally = tally;
+thread_local ll *whichtally = tally;
 
-vector<segment*> acknowledged;
+thread_local vector<segment*> acknowledged;
+
+/** when evaluating moves in parallel, the 'seen' values are kept here rather than in the segments */
+thread_local std::unordered_map<segment*, int> *ack_seen = nullptr;
+
+int seen_of(segment *p) {
+  if(!ack_seen) return p->seen;
+  auto it = ack_seen->find(p);
+  return it == ack_seen->end() ? -1 : it->second;
+  }
 
 void tallybox(qtybox& box, int d, int mul) {
   for(int i=box.minv; i<box.maxv; i++)
@@ -83,6 +92,16 @@ void tallybox(qtybox& box, int d, int mul) {
 
 void acknowledge(segment *p, int d) {
   if(!p) return;
+  if(ack_seen) {
+    auto it = ack_seen->find(p);
+    if(it == ack_seen->end()) {
+      ack_seen->emplace(p, d);
+      acknowledged.emplace_back(p);
+      }
+    else if(it->second > d)
+      it->second = d;
+    return;
+    }
   if(p->seen == -1) {
     p->seen = d;
     acknowledged.emplace_back(p);
@@ -93,17 +112,19 @@ void acknowledge(segment *p, int d) {
 
 void acknowledgments(int mul) {
   for(segment* p: acknowledged) {
-    tallybox(p->qty, p->seen, mul);
+    tallybox(p->qty, seen_of(p), mul);
     segment *p2 = p->parent;
     int dist = 1;
     while(p2) {
-      if(p2->seen != -1) {
-        tallybox(p->qty, p2->seen+dist, -mul);
+      int s2 = seen_of(p2);
+      if(s2 != -1) {
+        tallybox(p->qty, s2+dist, -mul);
         break;
         }
       p2=p2->parent; dist++;
       }
-    p->seen = -1;
+    if(ack_seen) ack_seen->erase(p);
+    else p->seen = -1;
     }
   acknowledged.clear();
   }
@@ -18,8 +18,15 @@ void full_evaluation() {
   eval.current = true;
 
   try {
+    int N = get_n();
+    vector<ld> radii(N);
+    /* zero_distance throws for abstract embeddings; make this happen on this thread */
+    if(N) current->zero_distance(0);
+    embeddings_for(N, [&] (int a, int b) {
+      for(int i=a; i<b; i++) radii[i] = current->zero_distance(i);
+      }, 256);
     eval.maxradius = 0;
-    for(int i=0; i<get_n(); i++) eval.maxradius = max(eval.maxradius, current->zero_distance(i));
+    for(auto r: radii) eval.maxradius = max(eval.maxradius, r);
     println(hlog, "maximum radius = ", eval.maxradius);
     }
   catch(hr_exception&) {}
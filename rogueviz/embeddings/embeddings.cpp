@@ -15,6 +15,12 @@ int get_n() {
   return isize(directed_edges);
   }
 
+/** like parallel_for, but also uses the threads requested with the RogueViz 'threads' setting */
+void embeddings_for(int N, const std::function<void(int, int)>& action, int min_chunk) {
+  dynamicval<int> wt(worker_threads, max(worker_threads, threads));
+  parallel_for(N, action, min_chunk);
+  }
+
 rogueviz::edgetype *any;
 
 edgetype *ensure_edge() {
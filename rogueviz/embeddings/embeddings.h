@@ -90,6 +90,28 @@ void prepare_goal(int goal);
 int get_n();
 int count_directed_edges();
 
+/* parallel passes over the vertices */
+
+void embeddings_for(int N, const std::function<void(int, int)>& action, int min_chunk = 1);
+
+/** the order in which the rows i of a triangular loop (j<i) should be visited, so that equal ranges have equal work */
+inline int balanced_row(int k, int N) { return (k & 1) ? N - 1 - k/2 : k/2; }
+
+/** a separate copy of T for every thread taking part in embeddings_for */
+template<class T> struct per_thread {
+  std::mutex lock;
+  std::map<std::thread::id, T> data;
+  T init;
+  per_thread(const T& init) : init(init) {}
+  T& get() {
+    std::unique_lock<std::mutex> lk(lock);
+    auto id = std::this_thread::get_id();
+    auto it = data.find(id);
+    if(it == data.end()) it = data.emplace(id, init).first;
+    return it->second;
+    }
+  };
+
 void read_edgelist(const string& fn);
 void read_polar(const string& fn);
 
@@ -68,91 +68,95 @@ vector<array<ll, 2>> disttable_approx;
 
 ld llcont_approx_prec = 10000;
 
-void build_disttable_approx() {
-  indenter_finish im("build_disttable_approx");
+/** the number of buckets of disttable_approx we expect to need, from the triangle inequality; 0 if unknown */
+int disttable_approx_bound() {
+  int N = get_n();
+  ld maxr = 0;
+  try {
+    for(int i=0; i<N; i++) maxr = max(maxr, current->zero_distance(i));
+    }
+  catch(hr_exception&) { return 0; }
+  ld bound = 2 * maxr * llcont_approx_prec + 2;
+  if(!(bound < (1<<24))) return 0;
+  return int(bound);
+  }
 
-  array<ll, 2> zero = {0, 0};
+/** the number of pairs tallied by the last build_disttable_approx */
+ll disttable_pairs;
 
-  using namespace rogueviz;
+/** common part of build_disttable_approx and build_disttable_approx_undirected: tally all the pairs (i, j) given by each_pair(i, tab, f) */
+template<class T> void tally_disttable_approx(const char *name, const T& each_pair) {
+  indenter_finish im(name);
 
-  std::vector<vector<array<ll, 2>>> results(threads);
-  std::vector<std::thread> v;
+  array<ll, 2> zero = {0, 0};
   int N = get_n();
-  for(int k=0; k<threads; k++)
-    v.emplace_back([&,k] () {
-      auto& dt = results[k];
-      vector<int> tab(N, N);
-      auto p = k ? nullptr : new progressbar(N/threads, "build_disttable_approx");
-      for(int i=k; i<N; i+=threads) {
-        if(p) (*p)++;
-        for(auto p: vdata[i].edges) {
-          int j = p.second->i ^ p.second->j ^ i;
-          if(j<i) tab[j] = i;
-          }
-        for(int j=0; j<i; j++) {
-          ld dist = current->distance(i, j);
-          if(dist < 0) continue;
-          int dista = dist * llcont_approx_prec;
-          if(isize(dt) < dista+1)
-            dt.resize(dista+1, zero);
-          dt[dista][(tab[j] == i) ? 1 : 0]++;
-          }
-        }
-      if(p) delete p;
-      });
-  for(std::thread& t:v) t.join();
+
+  struct tally {
+    vector<array<ll, 2>> dt;
+    vector<int> tab;
+    ll pairs = 0;
+    };
+  tally init;
+  init.dt.resize(disttable_approx_bound(), zero);
+  init.tab.resize(N, N);
+  per_thread<tally> results(init);
+
+  progressbar pb(N, name);
+  std::mutex pb_lock;
+
+  embeddings_for(N, [&] (int a, int b) {
+    auto& t = results.get();
+    auto& dt = t.dt;
+    for(int k=a; k<b; k++) {
+      int i = balanced_row(k, N);
+      each_pair(i, t.tab, [&] (int j, bool edge) {
+        ld dist = current->distance(i, j);
+        if(dist < 0) return;
+        int dista = dist * llcont_approx_prec;
+        if(isize(dt) < dista+1)
+          dt.resize(max(dista+1, isize(dt) * 2), zero);
+        dt[dista][edge ? 1 : 0]++;
+        t.pairs++;
+        });
+      }
+    std::unique_lock<std::mutex> lk(pb_lock);
+    for(int k=a; k<b; k++) pb++;
+    }, 16);
 
   int mx = 0;
-  for(auto& r: results) mx = max(mx, isize(r));
+  disttable_pairs = 0;
+  for(auto& r: results.data) {
+    auto& dt = r.second.dt;
+    for(int i=isize(dt)-1; i>=mx; i--) if(dt[i][0] || dt[i][1]) { mx = i+1; break; }
+    disttable_pairs += r.second.pairs;
+    }
   disttable_approx.clear();
   disttable_approx.resize(mx, zero);
 
-  for(auto& r: results)
-    for(int i=0; i<isize(r); i++)
+  for(auto& r: results.data) {
+    auto& dt = r.second.dt;
+    for(int i=0; i<min(mx, isize(dt)); i++)
       for(int j=0; j<2; j++)
-        disttable_approx[i][j] += r[i][j];
+        disttable_approx[i][j] += dt[i][j];
+    }
   }
 
-void build_disttable_approx_undirected() {
-  indenter_finish im("build_disttable_approx_undirected");
-
-  array<ll, 2> zero = {0, 0};
-
-  using namespace rogueviz;
+void build_disttable_approx() {
+  tally_disttable_approx("build_disttable_approx", [] (int i, vector<int>& tab, const auto& f) {
+    for(auto p: vdata[i].edges) {
+      int j = p.second->i ^ p.second->j ^ i;
+      if(j<i) tab[j] = i;
+      }
+    for(int j=0; j<i; j++) f(j, tab[j] == i);
+    });
+  }
 
-  std::vector<vector<array<ll, 2>>> results(threads);
-  std::vector<std::thread> v;
-  int N = get_n();
-  for(int k=0; k<threads; k++)
-    v.emplace_back([&,k] () {
-      auto& dt = results[k];
-      vector<int> tab(N, N);
-      auto p = k ? nullptr : new progressbar(N/threads, "build_disttable_approx");
-      for(int i=k; i<N; i+=threads) {
-        if(p) (*p)++;
-        for(auto j: directed_edges[i]) tab[j] =	i;
-        for(int j=0; j<N; j++) if(j != i) {
-          ld dist = current->distance(i, j);
-          if(dist < 0) continue;
-          int dista = dist * llcont_approx_prec;
-          if(isize(dt) < dista+1)
-            dt.resize(dista+1, zero);
-          dt[dista][(tab[j] == i) ? 1 : 0]++;
-          }
-        }
-      if(p) delete p;
-      });
-  for(std::thread& t:v) t.join();
-  
-  int mx = 0;
-  for(auto& r: results) mx = max(mx, isize(r));
-  disttable_approx.clear();
-  disttable_approx.resize(mx, zero);
-  
-  for(auto& r: results)
-    for(int i=0; i<isize(r); i++) 
-      for(int j=0; j<2; j++)
-        disttable_approx[i][j] += r[i][j];
+void build_disttable_approx_undirected() {
+  tally_disttable_approx("build_disttable_approx_undirected", [] (int i, vector<int>& tab, const auto& f) {
+    int N = get_n();
+    for(auto j: directed_edges[i]) tab[j] = i;
+    for(int j=0; j<N; j++) if(j != i) f(j, tab[j] == i);
+    });
   }
 
 ld loglik_cont_approx(logistic& l) {
@@ -194,10 +198,8 @@ void fix_logistic_parameters(logistic& l, const logisticfun& f, const char *name
     }
   }
 
-void fast_loglik_cont(logistic& l, const logisticfun& f, const char *name, ld start, ld eps) {
-
-  if(name) println(hlog, "fix_logistic_parameters");
-  indenter_finish im(name);
+/** the search of fast_loglik_cont, without the indenter */
+static void fit_logistic(logistic& l, const logisticfun& f, const char *name, ld start, ld eps) {
   ld cur = f(l);
   if(name) println(hlog, hr::format("%s = %20.10" PLDF " (R=%10.5" PLDF " T=%" PLDF ")", name, cur, l.R, l.T));
 
@@ -235,8 +237,35 @@ void fast_loglik_cont(logistic& l, const logisticfun& f, const char *name, ld st
     }
   }
 
+void fast_loglik_cont(logistic& l, const logisticfun& f, const char *name, ld start, ld eps) {
+  /* without a name, this may be called from worker threads, which must not touch hlog.indentation */
+  if(!name) return fit_logistic(l, f, name, start, eps);
+  println(hlog, "fix_logistic_parameters");
+  indenter_finish im;
+  fit_logistic(l, f, name, start, eps);
+  }
+
 logistic cont_logistic;
 
+/** time build_disttable_approx (and greedy routing, if routing) and report the number of pairs per second */
+void disttable_benchmark(bool routing) {
+  int t1 = SDL_GetTicks();
+  build_disttable_approx();
+  int t2 = SDL_GetTicks();
+  int thr = max(worker_threads, threads);
+  println(hlog, "disttable: ", hr::format("%lld", disttable_pairs), " pairs in ", t2-t1, " ms on ", thr, " threads, ",
+    hr::format("%.0f", disttable_pairs * 1000. / max(t2-t1, 1)), " pairs/s");
+  if(routing) {
+    prepare_pairs();
+    iddata d;
+    t1 = SDL_GetTicks();
+    greedy_routing(d);
+    t2 = SDL_GetTicks();
+    println(hlog, "routing: ", hr::format("%.0f", d.tot), " pairs in ", t2-t1, " ms on ", thr, " threads, ",
+      hr::format("%.0f", d.tot * 1000. / max(t2-t1, 1)), " pairs/s");
+    }
+  }
+
 int loglik_args() {
   using namespace arg;
 
@@ -245,6 +274,9 @@ int loglik_args() {
     fast_loglik_cont(cont_logistic, loglik_cont_approx, "lcont", 1, 1e-6);
     // return loglik_cont();
     }
+  else if(argis("-loglik-bench")) {
+    shift(); disttable_benchmark(argi());
+    }
   else if(argis("-loglik-precise")) {
     build_disttable();
     fast_loglik_cont(cont_logistic, loglik_cont, "lcont", 1, 1e-6);
@@ -12,7 +12,11 @@ loglik_info analyze_mdl_symmetric(bool symmetric) {
   if(dim == 1) return li;
 
   vector<ld> center_distances(N);
-  for(int id=0; id<N; id++) center_distances[id] = current->zero_distance(id);
+  /* zero_distance throws for abstract embeddings; make this happen on this thread */
+  if(N) current->zero_distance(0);
+  embeddings_for(N, [&] (int a, int b) {
+    for(int id=a; id<b; id++) center_distances[id] = current->zero_distance(id);
+    }, 256);
 
   build_disttable_approx();
   logistic cont;
@@ -64,32 +68,37 @@ loglik_info analyze_mdl_symmetric(bool symmetric) {
     println(hlog, "computing TAL");
     bad.resize(N);
     good.resize(N);
-    vector<int> last_id(N, -1);
-    ld total_loglik = 0;
-    for(int i=0; i<N; i++) {
-      for(int j: directed_edges[i]) last_id[j] = i;
-      for(int j=0; j<N; j++) {
-        if(last_id[j] == i)
-          good[i].push_back(current->distance(i, j));
-        else
-          bad[i].push_back(current->distance(i, j));
-        }
-      sort(good[i].begin(), good[i].end());
-      sort(bad[i].begin(), bad[i].end());
-
-      auto fun = [&] (logistic& l) {
-        ld res = 0;
-        for(auto& g: good[i]) res += l.lyes(g);
-        for(auto& b: bad[i]) res += l.lno(b);
-        return res;
-        };
-
-      if(good[i].size() && bad[i].size() && good[i].back() >= bad[i][0]) {
-        fast_loglik_cont(logistics[i], fun, nullptr, 1, 1e-6);
-        total_loglik += -fun(logistics[i]);
-        // println(hlog, i, ": R=", logistics[i].R, " T=", logistics[i].T, " f = ", -fun(logistics[i]));
+    vector<ld> logliks(N, 0);
+    per_thread<vector<int>> last_ids(vector<int>(N, -1));
+    embeddings_for(N, [&] (int a, int b) {
+      auto& last_id = last_ids.get();
+      for(int i=a; i<b; i++) {
+        for(int j: directed_edges[i]) last_id[j] = i;
+        for(int j=0; j<N; j++) {
+          if(last_id[j] == i)
+            good[i].push_back(current->distance(i, j));
+          else
+            bad[i].push_back(current->distance(i, j));
+          }
+        sort(good[i].begin(), good[i].end());
+        sort(bad[i].begin(), bad[i].end());
+
+        auto fun = [&] (logistic& l) {
+          ld res = 0;
+          for(auto& g: good[i]) res += l.lyes(g);
+          for(auto& b: bad[i]) res += l.lno(b);
+          return res;
+          };
+
+        if(good[i].size() && bad[i].size() && good[i].back() >= bad[i][0]) {
+          fast_loglik_cont(logistics[i], fun, nullptr, 1, 1e-6);
+          logliks[i] = -fun(logistics[i]);
+          // println(hlog, i, ": R=", logistics[i].R, " T=", logistics[i].T, " f = ", -fun(logistics[i]));
+          }
         }
-      }
+      });
+    ld total_loglik = 0;
+    for(auto l: logliks) total_loglik += l;
     println(hlog, "total asymmetric loglikelihood = ", total_loglik);
     }
 
@@ -118,19 +127,23 @@ loglik_info analyze_mdl_symmetric(bool symmetric) {
     ld extra_info = 0;
     if(symmetric) extra_info = -llcont_eps(eps)(cont);
     if(!symmetric) {
-      for(int i=0; i<N; i++) {
-        auto last = logistics[i];
-        auto fun = [&] (logistic& l) {
-          ld res = 0;
-          for(auto& g: good[i]) res += l.lyes(g+eps) + l.lyes(g-eps);
-          for(auto& b: bad[i]) res += l.lno(b+eps) + l.lno(b-eps);
-          return res/2;
-          };
-        if(good[i].size() && bad[i].size() && good[i].back() >= bad[i][0] - 2 * eps) {
-          fast_loglik_cont(last, fun, nullptr, 0.1, 1e-4);
-          extra_info -= fun(last);
+      vector<ld> infos(N, 0);
+      embeddings_for(N, [&] (int a, int b) {
+        for(int i=a; i<b; i++) {
+          auto last = logistics[i];
+          auto fun = [&] (logistic& l) {
+            ld res = 0;
+            for(auto& g: good[i]) res += l.lyes(g+eps) + l.lyes(g-eps);
+            for(auto& b: bad[i]) res += l.lno(b+eps) + l.lno(b-eps);
+            return res/2;
+            };
+          if(good[i].size() && bad[i].size() && good[i].back() >= bad[i][0] - 2 * eps) {
+            fast_loglik_cont(last, fun, nullptr, 0.1, 1e-4);
+            infos[i] = -fun(last);
+            }
           }
-        }
+        });
+      for(auto x: infos) extra_info += x;
       }
     if(report) {
       println(hlog, "FOR epsilon = ", eps);
@@ -11,42 +11,55 @@ struct pairdata { ld success, route_length, modded_success, modded_route_length;
 
 vector<vector<char> > actual;
 
-vector<pairdata> pairs;
+/** the state of greedy routing towards a single goal; every thread routing in parallel has its own */
+struct router {
+  vector<pairdata> pairs;
+  vector<int> last_goal;
+  vector<int> next_stop;
+
+  void reset(int N) {
+    pairs.clear(); pairs.resize(N);
+    last_goal.clear(); last_goal.resize(N, -1);
+    next_stop.clear(); next_stop.resize(N, -1);
+    }
+
+  void route_from(int src, int goal, const vector<ld>& distances_from_goal);
+  void greedy_routing_to(iddata& d, int goal);
+  };
 
-vector<int> last_goal;
-vector<int> next_stop;
+router main_router;
 
 void prepare_pairs() {
   int N = get_n();
-  pairs.resize(N);
   actual.resize(N);
   for(int i=0; i<N; i++) actual[i].clear();
-  for(int i=0; i<N; i++) actual[i].resize(N, NOYET);
   progressbar pb(N, "prepare pairs");
-  for(int i=0; i<N; i++) {
-    vector<int> bfsqueue;
-    auto& p = actual[i];
-    auto visit = [&] (int j, int d) {
-      if(p[j] == NOYET) {
-        p[j] = d;
-        bfsqueue.push_back(j);
+  std::mutex pb_lock;
+  embeddings_for(N, [&] (int a, int b) {
+    for(int i=a; i<b; i++) {
+      vector<int> bfsqueue;
+      auto& p = actual[i];
+      p.resize(N, NOYET);
+      auto visit = [&] (int j, int d) {
+        if(p[j] == NOYET) {
+          p[j] = d;
+          bfsqueue.push_back(j);
+          }
+        };
+      visit(i, 0);
+      for(int k=0; k<isize(bfsqueue); k++) {
+        int a = bfsqueue[k];
+        for(auto ed: rogueviz::vdata[a].edges)
+          visit(ed.first, p[a] + 1);
         }
-      };
-    visit(i, 0);
-    for(int k=0; k<isize(bfsqueue); k++) {
-      int a = bfsqueue[k];
-      for(auto ed: rogueviz::vdata[a].edges)
-        visit(ed.first, p[a] + 1);
       }
-    pb++;
-    }
-  last_goal.clear();
-  last_goal.resize(N, -1);
-  next_stop.clear();
-  next_stop.resize(N, -1);
+    std::unique_lock<std::mutex> lk(pb_lock);
+    for(int i=a; i<b; i++) pb++;
+    }, 16);
+  main_router.reset(N);
   }
 
-void route_from(int src, int goal, const vector<ld>& distances_from_goal) {
+void router::route_from(int src, int goal, const vector<ld>& distances_from_goal) {
   if(last_goal[src] == goal) return;
   if(src == goal) {
     pairs[src].success = 1;
@@ -108,7 +121,7 @@ void route_from(int src, int goal, const vector<ld>& distances_from_goal) {
   last_goal[src] = goal;
   }
 
-void greedy_routing_to(iddata& d, int goal) {
+void router::greedy_routing_to(iddata& d, int goal) {
   int N = get_n();
   vector<ld> distances_from_goal(N);
   for(int src=0; src<N; src++)
@@ -135,9 +148,29 @@ void greedy_routing_to(iddata& d, int goal) {
     }
   }
 
-void greedy_routing(iddata& d) {
+/** route to every goal in [0, N) in parallel; the results are added in the order of goals, so they do not depend on the threads */
+void greedy_routing_all(iddata& d, progressbar *pb) {
   int N = get_n();
-  for(int goal=0; goal<N; goal++) greedy_routing_to(d, goal);
+  router init;
+  init.reset(N);
+  per_thread<router> routers(init);
+  vector<iddata> results(N);
+  std::mutex pb_lock;
+  embeddings_for(N, [&] (int a, int b) {
+    auto& r = routers.get();
+    for(int goal=a; goal<b; goal++) r.greedy_routing_to(results[goal], goal);
+    if(!pb) return;
+    std::unique_lock<std::mutex> lk(pb_lock);
+    for(int goal=a; goal<b; goal++) (*pb)++;
+    });
+  for(auto& r: results) {
+    d.tot += r.tot; d.suc += r.suc; d.routedist += r.routedist; d.eff += r.eff;
+    d.msuc += r.msuc; d.mroutedist += r.mroutedist; d.meff += r.meff;
+    }
+  }
+
+void greedy_routing(iddata& d) {
+  greedy_routing_all(d, nullptr);
   }
 
 #if 0
@@ -197,14 +230,14 @@ void routing_test(string s) {
 int current_goal;
 iddata prepared;
 void prepare_goal(int goal) {
-  greedy_routing_to(prepared, current_goal = goal);
+  main_router.greedy_routing_to(prepared, current_goal = goal);
   }
 
 vector<int> path(int src) {
   vector<int> res;
   while(src != -1) {
     res.push_back(src);
-    src = next_stop[src];
+    src = main_router.next_stop[src];
     }
   return res;
   }
@@ -217,12 +250,8 @@ iddata full_routing() {
   iddata result;
   prepare_pairs();
   if(1) {
-    int N = get_n();
-    progressbar pb(N, "greedy routing");
-    for(int goal=0; goal<N; goal++) {
-      pb++;
-      greedy_routing_to(result, goal);
-      }
+    progressbar pb(get_n(), "greedy routing");
+    greedy_routing_all(result, &pb);
     }
   println(hlog, "greedy routing: success = ", result.suc / result.tot, " stretch = ", result.routedist / result.suc, " efficiency = ", result.eff / result.tot);
   println(hlog, "modded routing: success = ", result.msuc / result.tot, " stretch = ", result.mroutedist / result.msuc, " efficiency = ", result.meff / result.tot);
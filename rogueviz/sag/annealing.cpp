@@ -208,6 +208,165 @@ void dofullsa_iterations(long long saiter) {
   create_viz();
   }
 
+/** \brief one replica of the multi-chain SA (parallel tempering)
+ *
+ *  Each chain has its own placement, temperature and random generator, and only reads the shared tables
+ *  (sagdist, the edges, the loglik tables), so the chains can run on separate threads.
+ */
+struct sag_chain {
+  vector<int> sagid, sagnode;
+  double cost;
+  ld temperature;
+  std::mt19937 rng;
+  long long moves, nomoves, swaps_tried, swaps_done;
+
+  int rand(int i) { return std::uniform_int_distribution<int>(0, i-1)(rng); }
+  bool chance(double p) { return std::uniform_real_distribution<double>(0, 1)(rng) < p; }
+
+  /** the same move as saiter(), but on this chain */
+  void iter() {
+    int DN = isize(sagid);
+    int t1 = rand(DN);
+    int sid1 = sagid[t1];
+
+    int sid2;
+
+    int s = twoway ? (rand(2) ? 4 : 1) : rand(4)+1;
+
+    if(s == 4) sid2 = rand(isize(sagcells));
+    else {
+      sid2 = sid1;
+      for(int ii=0; ii<s; ii++) sid2 = neighbors[sid2][rand(isize(neighbors[sid2]))];
+      }
+    int t2 = allow_doubles ? -1 : sagnode[sid2];
+
+    if(fixed_position[t1] || (t2 >= 0 && fixed_position[t2])) return;
+
+    sagnode[sid1] = -1; sagid[t1] = -1;
+    sagnode[sid2] = -1; if(t2 >= 0) sagid[t2] = -1;
+
+    double change =
+      costat(sagid, sagnode, t1, sid2) + costat(sagid, sagnode, t2, sid1) - costat(sagid, sagnode, t1, sid1) - costat(sagid, sagnode, t2, sid2);
+
+    sagnode[sid1] = t1; sagid[t1] = sid1;
+    sagnode[sid2] = t2; if(t2 >= 0) sagid[t2] = sid2;
+
+    if(change > 0 && !chance(exp(-change * exp(-temperature)))) { nomoves++; return; }
+    moves++;
+
+    sagnode[sid1] = t2; sagnode[sid2] = t1;
+    sagid[t1] = sid2; if(t2 >= 0) sagid[t2] = sid1;
+
+    cost += change;
+    }
+  };
+
+/** how many iterations each chain does between replica exchanges */
+int exchange_each = 10000;
+
+/** print the state of the chains after this many exchange rounds (0 = only at the end) */
+int chain_report_each = 100;
+
+void report_chains(const vector<sag_chain>& chains, long long rounds) {
+  println(hlog, format("after %lld rounds:", rounds));
+  for(auto& c: chains)
+    println(hlog, format("  temp %8.4f cost %12.2f accept %6.4f exchange %6.4f",
+      double(c.temperature), c.cost,
+      c.moves / (c.moves + c.nomoves + 1e-9), c.swaps_done / (c.swaps_tried + 1e-9)));
+  hlog.flush();
+  }
+
+/** \brief parallel tempering: run K chains at fixed temperatures between lowtemp and hightemp, on worker_threads threads
+ *
+ *  Each chain starts from the current placement and does `iterations` SA steps; every exchange_each steps,
+ *  the placements of chains with adjacent temperatures may be exchanged (Metropolis criterion).
+ *  The best placement found becomes the current one, so it can be saved with -sag-save-sol.
+ *  The result depends only on the random state at the start, not on the number of threads.
+ */
+void dofullsa_chains(int K, long long iterations) {
+  if(K < 1) K = 1;
+  compute_cost();
+
+  vector<sag_chain> chains(K);
+  for(int k=0; k<K; k++) {
+    auto& c = chains[k];
+    c.sagid = sagid; c.sagnode = sagnode; c.cost = cost;
+    c.temperature = K == 1 ? lowtemp : lowtemp + (hightemp - lowtemp) * k / (K - 1.);
+    c.rng.seed(hrngen());
+    c.moves = c.nomoves = c.swaps_tried = c.swaps_done = 0;
+    }
+
+  vector<int> best_sagid = sagid, best_sagnode = sagnode;
+  double best_cost = cost;
+
+  long long rounds = (iterations + exchange_each - 1) / exchange_each;
+  for(long long r=0; r<rounds; r++) {
+    long long steps = min<long long>(exchange_each, iterations - r * exchange_each);
+    parallel_for(K, [&] (int a, int b) {
+      for(int k=a; k<b; k++) for(long long i=0; i<steps; i++) chains[k].iter();
+      }, 1);
+    numiter += steps * K;
+
+    for(auto& c: chains) if(c.cost < best_cost) best_cost = c.cost, best_sagid = c.sagid, best_sagnode = c.sagnode;
+
+    /* replica exchange between neighboring temperatures; alternate even and odd pairs */
+    for(int k=r&1; k+1<K; k+=2) {
+      auto& c1 = chains[k];
+      auto& c2 = chains[k+1];
+      double delta = (exp(-c1.temperature) - exp(-c2.temperature)) * (c1.cost - c2.cost);
+      c1.swaps_tried++; c2.swaps_tried++;
+      if(delta >= 0 || chance(exp(delta))) {
+        swap(c1.sagid, c2.sagid); swap(c1.sagnode, c2.sagnode); swap(c1.cost, c2.cost);
+        c1.swaps_done++; c2.swaps_done++;
+        }
+      }
+
+    if(debug_progress && chain_report_each && (r+1) % chain_report_each == 0) report_chains(chains, r+1);
+    }
+
+  if(debug_progress) report_chains(chains, rounds);
+
+  sagid = best_sagid; sagnode = best_sagnode;
+  compute_cost();
+  println(hlog, "best cost found by ", K, " chains: ", best_cost, " (recomputed: ", cost, ")");
+
+  temperature = -5;
+  sagmode = sagOff;
+  create_viz();
+  }
+
+/** compare the speed of SA steps with the dense sagdist table and with the rows computed on demand; the placement is restored afterwards */
+void oracle_bench(long long iterations) {
+  auto saved_sagid = sagid, saved_sagnode = sagnode;
+  auto saved_mode = sagmode;
+  auto saved_temperature = temperature;
+  compute_cost();
+  auto saved_cost = cost;
+  sagmode = sagSA; temperature = lowtemp;
+
+  auto run = [&] (const string& what) {
+    sagid = saved_sagid; sagnode = saved_sagnode; cost = saved_cost;
+    auto& c = sagdist_t::row_cache();
+    auto h = c.hits, m = c.misses;
+    int t1 = SDL_GetTicks();
+    for(long long i=0; i<iterations; i++) saiter();
+    int t2 = SDL_GetTicks();
+    println(hlog, what, ": ", t2-t1, " ms, cost = ", cost, ", row cache hits = ", format("%lld", c.hits - h), ", misses = ", format("%lld", c.misses - m));
+    };
+
+  if(sagdist.tab) run("dense table");
+  if(sagdist.row_generator) {
+    auto tab = sagdist.tab;
+    sagdist.tab = nullptr; sagdist.generation++;
+    run("on demand");
+    sagdist.tab = tab; sagdist.generation++;
+    }
+  else println(hlog, "no row generator, cannot compute the rows on demand");
+
+  sagid = saved_sagid; sagnode = saved_sagnode; cost = saved_cost;
+  sagmode = saved_mode; temperature = saved_temperature;
+  }
+
 int anneal_read_args() {
 #if CAP_COMMANDLINE
   using namespace arg;
@@ -231,6 +390,20 @@ int anneal_read_args() {
   else if(argis("-sagfulli")) {
     shift(); sag::dofullsa_iterations(argll());
     }
+
+  else if(argis("-sag-chains")) {
+    shift(); int K = argi();
+    shift(); sag::dofullsa_chains(K, argll());
+    }
+
+  else if(argis("-sag-oracle-bench")) {
+    shift(); sag::oracle_bench(argll());
+    }
+
+  else if(argis("-sag-exchange")) {
+    shift(); exchange_each = max(argi(), 1);
+    shift(); chain_report_each = argi();
+    }
   else if(argis("-sagmode")) {
     shift();
     vizsa_start = 0;
@@ -53,9 +53,79 @@ ld pdist(hyperpoint hi, hyperpoint hj);
 /** the maximum value in sagdist +1 */
 int max_sag_dist;
 
+void compute_max_sag_dist();
+
 /** new style cell request */
 int cell_request;
 
+/** compute the rows of sagdist on demand, rather than storing the whole table */
+bool sag_on_demand = false;
+
+/** the memory used by the row caches, in MB; split evenly between the threads */
+int sag_row_cache_mb = 256;
+
+/** the number of threads which may use the row caches */
+int sag_cache_shares() { return max({1, worker_threads, threads}); }
+
+/** a LRU cache of rows of sagdist; every thread has its own */
+struct sagdist_row_cache {
+  using distance = unsigned short;
+  int generation = -1, shares = 0;
+  size_t N = 0;
+  int capacity = 0, used = 0, head = -1, tail = -1;
+  /** separate allocations, so that the rows returned stay valid while the cache grows */
+  vector<vector<distance>> data;
+  vector<int> row_of, prev, next;
+  std::unordered_map<int, int> slot_of;
+  long long hits = 0, misses = 0;
+
+  void reset(int gen, size_t _N) {
+    generation = gen; N = _N; shares = sag_cache_shares();
+    capacity = max<long long>(16, (long long) sag_row_cache_mb * 1048576 / shares / (N * sizeof(distance) + 1));
+    data.clear(); row_of.clear(); prev.clear(); next.clear(); slot_of.clear();
+    used = 0; head = tail = -1;
+    }
+
+  void unlink(int s) {
+    if(prev[s] >= 0) next[prev[s]] = next[s]; else head = next[s];
+    if(next[s] >= 0) prev[next[s]] = prev[s]; else tail = prev[s];
+    }
+
+  void push_front(int s) {
+    prev[s] = -1; next[s] = head;
+    if(head >= 0) prev[head] = s; else tail = s;
+    head = s;
+    }
+
+  /** the row y, or nullptr (then get_slot() to fill it) */
+  distance *find(int y) {
+    auto it = slot_of.find(y);
+    if(it == slot_of.end()) return nullptr;
+    int s = it->second;
+    if(s != head) unlink(s), push_front(s);
+    hits++;
+    return &data[s][0];
+    }
+
+  /** a slot for row y, evicting the least recently used row if needed */
+  distance *get_slot(int y) {
+    misses++;
+    int s;
+    if(used < capacity) {
+      s = used++;
+      data.emplace_back(N); row_of.push_back(y); prev.push_back(-1); next.push_back(-1);
+      }
+    else {
+      s = tail; unlink(s);
+      slot_of.erase(row_of[s]);
+      row_of[s] = y;
+      }
+    slot_of[y] = s;
+    push_front(s);
+    return &data[s][0];
+    }
+  };
+
 /** the structure type used to hold a N*N table of distances */
 struct sagdist_t {
   using distance = unsigned short;
@@ -65,12 +135,70 @@ struct sagdist_t {
   size_t N;
   int format;
 
+  /** computes the row y; set by whatever computed the distances, and used to get the rows when tab is nullptr */
+  std::function<void(int, distance*)> row_generator;
+
+  /** the rows obtained from row_generator are clamped to this value */
+  distance limit = 65535;
+
+  /** the distance between cells which are not connected; never clamped */
+  distance unreachable = 65535;
+
+  /** changes whenever row_generator changes, invalidating the row caches */
+  int generation = 0;
+
+  /** only for a table in memory; use for_all() otherwise */
   distance* begin() { return tab; }
   distance* end() { return tab+N*N; }
 
   sagdist_t() { tab = nullptr; fd = 0; format = 1; }
 
-  distance* operator [] (int y) { return tab + N * y; }
+  distance* operator [] (int y) { return tab ? tab + N * y : cached_row(y); }
+
+  static sagdist_row_cache& row_cache() {
+    static thread_local sagdist_row_cache cache;
+    return cache;
+    }
+
+  distance* cached_row(int y) {
+    auto& c = row_cache();
+    if(c.generation != generation || c.N != N || c.shares != sag_cache_shares()) c.reset(generation, N);
+    if(auto r = c.find(y)) return r;
+    if(!row_generator) throw hr_exception("sagdist: no table and no row generator");
+    auto r = c.get_slot(y);
+    row_generator(y, r);
+    if(limit < unreachable) for(size_t j=0; j<N; j++) if(r[j] != unreachable) r[j] = min(r[j], limit);
+    return r;
+    }
+
+  /** call f for every entry of the table, without storing the table if it is computed on demand */
+  template<class T> void for_all(const T& f) {
+    if(tab) { for(auto x: *this) f(x); return; }
+    vector<distance> row(N);
+    for(size_t y=0; y<N; y++) {
+      row_generator(y, &row[0]);
+      for(auto x: row) f(x == unreachable ? x : min(x, limit));
+      }
+    }
+
+  /** set the rows to be computed by gen: either computed now (in parallel if par), or on demand (if sag_on_demand) */
+  void set_rows(int _N, const std::function<void(int, distance*)>& gen, bool par) {
+    if(sag_on_demand) {
+      clear();
+      N = _N;
+      }
+    else {
+      init(_N, 0);
+      auto fill = [&] (int i) {
+        if(debug_progress && i % 500 == 0) println(hlog, "computing distances for ", i, "/", _N);
+        gen(i, (*this)[i]);
+        };
+      if(par) parallelize(N, [&] (int a, int b) { for(int i=a; i<b; i++) fill(i); return 0; });
+      else for(size_t i=0; i<N; i++) fill(i);
+      }
+    row_generator = gen;
+    generation++;
+    }
 
   void init(int _N, distance val) {
     clear();
@@ -139,8 +267,108 @@ struct sagdist_t {
     for(auto& row: old) for(auto val: row) *(ptr++) = val;
     }
 
+  #if CAP_ZLIB
+  /* the tiled format: the magic string, N, the number of rows per tile, the offsets of the tiles (and the end),
+   * then every tile compressed with zlib; in a tile, every row except the first is stored as its difference
+   * from the previous row, which makes the rows of neighboring cells compress very well */
+
+  static constexpr const char* tiled_magic = "SAGDTIL1";
+
+  /** the number of rows in one tile of the tiled format */
+  static constexpr int tile_rows = 32;
+
+  void save_tiled(string fname) {
+    DEBBI(debug_init_sag, ("save_tiled ", fname));
+    fhstream f(fname, "wb");
+    if(!f.f) return file_error(fname);
+    size_t tiles = (N + tile_rows - 1) / tile_rows;
+    vector<long long> offsets(tiles+1, 0);
+    fwrite(tiled_magic, 8, 1, f.f);
+    long long n = N; int tr = tile_rows;
+    fwrite(&n, 8, 1, f.f);
+    fwrite(&tr, 4, 1, f.f);
+    auto table_at = ftell(f.f);
+    fwrite(&offsets[0], 8, tiles+1, f.f);
+    vector<distance> tile(N * tile_rows), last(N);
+    vector<Bytef> packed;
+    long long total = 0;
+    for(size_t t=0; t<tiles; t++) {
+      size_t rows = min<size_t>(tile_rows, N - t * tile_rows);
+      for(size_t r=0; r<rows; r++) {
+        distance *row = (*this)[t * tile_rows + r];
+        for(size_t j=0; j<N; j++) tile[r*N+j] = r ? distance(row[j] - last[j]) : row[j];
+        for(size_t j=0; j<N; j++) last[j] = row[j];
+        }
+      uLongf len = compressBound(rows * N * sizeof(distance));
+      packed.resize(len);
+      if(compress2(&packed[0], &len, (Bytef*) &tile[0], rows * N * sizeof(distance), 6) != Z_OK)
+        throw hr_exception("compression error");
+      fwrite(&packed[0], 1, len, f.f);
+      offsets[t] = total; total += len;
+      }
+    offsets[tiles] = total;
+    fseek(f.f, table_at, SEEK_SET);
+    fwrite(&offsets[0], 8, tiles+1, f.f);
+    if(debug_init_sag) println(hlog, "saved ", int(tiles), " tiles, ", hr::format("%lld bytes instead of %lld", total, (long long) (N*N*sizeof(distance))));
+    }
+
+  /** load a table in the tiled format; the tiles stay compressed in memory, and the rows are decompressed on demand */
+  void load_tiled(string fname) {
+    DEBBI(debug_init_sag, ("load_tiled ", fname));
+    fhstream f(fname, "rb");
+    if(!f.f) throw hr_exception("cannot open " + fname);
+    char magic[8];
+    long long n; int tr;
+    if(fread(magic, 8, 1, f.f) < 1 || fread(&n, 8, 1, f.f) < 1 || fread(&tr, 4, 1, f.f) < 1) throw hr_exception("file error");
+    size_t tiles = (n + tr - 1) / tr;
+    vector<long long> offsets(tiles+1);
+    if(fread(&offsets[0], 8, tiles+1, f.f) < tiles+1) throw hr_exception("file error");
+    auto data = std::make_shared<string>(offsets[tiles], 0);
+    if(offsets[tiles] && fread(&(*data)[0], 1, offsets[tiles], f.f) < size_t(offsets[tiles])) throw hr_exception("file error");
+
+    clear();
+    N = n;
+    size_t NN = N;
+    int gen = generation + 1;
+    row_generator = [data, offsets, tr, NN, gen] (int y, distance *out) {
+      /* the last decompressed tile of this thread */
+      static thread_local vector<distance> tile;
+      static thread_local pair<int, int> tile_id = {-1, -1};
+      int t = y / tr;
+      if(tile_id != make_pair(gen, t)) {
+        size_t rows = min<size_t>(tr, NN - size_t(t) * tr);
+        tile.resize(rows * NN);
+        uLongf len = rows * NN * sizeof(distance);
+        if(uncompress((Bytef*) &tile[0], &len, (const Bytef*) &(*data)[offsets[t]], offsets[t+1] - offsets[t]) != Z_OK)
+          throw hr_exception("decompression error");
+        for(size_t r=1; r<rows; r++) for(size_t j=0; j<NN; j++) tile[r*NN+j] += tile[(r-1)*NN+j];
+        tile_id = make_pair(gen, t);
+        }
+      memcpy(out, &tile[(y % tr) * NN], NN * sizeof(distance));
+      };
+    generation = gen;
+    if(debug_init_sag) println(hlog, "loaded ", int(tiles), " tiles, ", hr::format("%lld", offsets[tiles]), " bytes, test: ", test());
+    }
+  #endif
+
+  static bool is_tiled(string fname) {
+    char magic[8] = {};
+    FILE *f = fopen(fname.c_str(), "rb");
+    if(!f) return false;
+    bool ok = fread(magic, 8, 1, f) == 1;
+    fclose(f);
+    return ok && string(magic, 8) == "SAGDTIL1";
+    }
+
   void load(string fname) {
-    if(format == 1) {
+    if(is_tiled(fname)) {
+      #if CAP_ZLIB
+      load_tiled(fname);
+      #else
+      throw hr_exception("tiled sagdist requires zlib");
+      #endif
+      }
+    else if(format == 1) {
       #ifdef LINUXX
       map(fname);
       #else
@@ -169,14 +397,17 @@ struct sagdist_t {
     #else
     if(debug_init_sag) println(hlog, "size is ", hr::format("%lld", (long long) size));
     #endif
-    char *p = (char*) tab;
-    while(size) {
-      size_t written = write(fd, p, size);
-      if(written <= 0) throw hr_exception("bad written");
-      p += written; size -= written;
-      }
+    auto write_all = [&] (char *p, size_t size) {
+      while(size) {
+        size_t written = write(fd, p, size);
+        if(written <= 0) throw hr_exception("bad written");
+        p += written; size -= written;
+        }
+      };
+    if(tab) write_all((char*) tab, size);
+    else for(size_t y=0; y<N; y++) write_all((char*) (*this)[y], N * sizeof(distance));
     if(debug_init_sag) println(hlog, "test: ", test());
-    ::close(fd);
+    ::close(fd); fd = 0;
     }
 
   void clear() {
@@ -186,6 +417,8 @@ struct sagdist_t {
     #endif
     delete[] tab;
     tab = nullptr; fd = 0;
+    row_generator = nullptr; limit = unreachable = 65535;
+    generation++;
     }
 
   ~sagdist_t() {
@@ -196,6 +429,31 @@ struct sagdist_t {
 
 sagdist_t sagdist;
 
+void compute_max_sag_dist() {
+  max_sag_dist = 0;
+  if(sagdist.tab)
+    for(auto x: sagdist) max_sag_dist = max<int>(max_sag_dist, x);
+  else if(sagdist.N) {
+    /* do not compute all the rows: d(i,j) <= d(i,0) + d(0,j), plus rounding, so twice the largest distance from 0 is enough */
+    auto row = sagdist[0];
+    bool connected = true;
+    for(size_t j=0; j<sagdist.N; j++) {
+      if(row[j] == sagdist.unreachable) connected = false;
+      else max_sag_dist = max<int>(max_sag_dist, row[j]);
+      }
+    if(connected) {
+      max_sag_dist = min(2 * max_sag_dist + 2, sagdist.unreachable - 1);
+      sagdist.limit = max_sag_dist;
+      sagdist.generation++;
+      }
+    /* the bound does not hold in the other components; as in the table, the unreachable pairs are the largest entries */
+    else max_sag_dist = sagdist.unreachable;
+    }
+  max_sag_dist++;
+  if(debug_init_sag)
+    println(hlog, "max_sag_dist = ", max_sag_dist);
+  }
+
 vector<hyperpoint> subcell_points;
 
 /** currently implemented only for Solv and Nil! */
@@ -267,19 +525,15 @@ void compute_dists() {
     }
   else if(gdist_prec && dijkstra_maxedge) {
     DEBBI(debug_init_sag, ("Computing Dijkstra distances..."));
-    sagdist.init(N, N);
-    vector<vector<pair<int, ld>>> dijkstra_edges(N);
+    auto dijkstra_edges = std::make_shared<vector<vector<pair<int, ld>>>>(N);
     for(int i=0; i<N; i++) {
       celllister cl(sagcells[i].first, dijkstra_maxedge, 50000, nullptr);
       for(auto c1: cl.lst) for(int q=0; q<Q; q++) if(c1 != sagcells[i].first || q != sagcells[i].second) if(ids.count({c1, q}))
-        dijkstra_edges[i].emplace_back(ids[{c1, q}], pdist(cellpoint[i], cellpoint[ids[{c1, q}]]));
-      if(i == 0) println(hlog, i, " has ", isize(dijkstra_edges[i]), " edges");
+        (*dijkstra_edges)[i].emplace_back(ids[{c1, q}], pdist(cellpoint[i], cellpoint[ids[{c1, q}]]));
+      if(i == 0) println(hlog, i, " has ", isize((*dijkstra_edges)[i]), " edges");
       }
-    parallelize(N, [&] (int a, int b) {
-    vector<ld> distances(N);
-    for(int i=a; i<b; i++) {
-      if(debug_progress && i % 500 == 0) println(hlog, "computing dijkstra for ", i , "/", N);
-      for(int j=0; j<N; j++) distances[j] = HUGE_VAL;
+    sagdist.set_rows(N, [N, dijkstra_edges] (int i, sagdist_t::distance *row) {
+      vector<ld> distances(N, HUGE_VAL);
       std::priority_queue<pair<ld, int>> pq;
       auto visit = [&] (int i, ld dist) {
         if(distances[i] <= dist) return;
@@ -291,47 +545,43 @@ void compute_dists() {
         ld d = -pq.top().first;
         int at = pq.top().second;
         pq.pop();
-        for(auto e: dijkstra_edges[at]) visit(e.first, d + e.second);
+        for(auto e: (*dijkstra_edges)[at]) visit(e.first, d + e.second);
         }
-      for(int j=0; j<N; j++) sagdist[i][j] = distances[j] * gdist_prec + .5;
-      }
-    return 0;
-    }
-    );
+      for(int j=0; j<N; j++) row[j] = distances[j] == HUGE_VAL ? 65535 : distances[j] * gdist_prec + .5;
+      }, true);
     if(debug_init_sag)
       println(hlog, "N0 = ", neighbors[0], " N1 = ", neighbors[1]);
     }
 
   else if(gdist_prec) {
     DEBBI(debug_init_sag, ("Computing distances... (N=", N, ")"));
-    sagdist.init(N, N);
-    ld mx = 1;
-    for(int i=0; i<N; i++)
-    for(int j=0; j<N; j++) {
-      ld d = pdist(cellpoint[i], cellpoint[j]);
-      sagdist[i][j] = (d + .5) * gdist_prec;
-      if(d > mx && debug_sag_cells)
-        println(hlog, kz(cellpoint[i]), kz(cellpoint[j]), " :: ", mx = d);
-      }
+    sagdist.set_rows(N, [N] (int i, sagdist_t::distance *row) {
+      /* the maximum is tracked per row, since rows may be generated concurrently */
+      ld mx = 1;
+      for(int j=0; j<N; j++) {
+        ld d = pdist(cellpoint[i], cellpoint[j]);
+        row[j] = (d + .5) * gdist_prec;
+        if(d > mx && debug_sag_cells)
+          println(hlog, kz(cellpoint[i]), kz(cellpoint[j]), " :: ", mx = d);
+        }
+      }, false);
     }
   
   else {
     DEBBI(debug_init_sag, ("no gdist_prec"));
-    sagdist.init(N, N);
-    for(int i=0; i<N; i++) {
-      auto sdi = sagdist[i];
+    sagdist.set_rows(N, [N] (int i, sagdist_t::distance *sdi) {
+      /* like a table initialized to N, but N might not fit */
+      sagdist_t::distance unseen = min(N, 65535);
+      for(int j=0; j<N; j++) sdi[j] = unseen;
       vector<int> q;
-      auto visit = [&] (int j, int dist) { if(sdi[j] < N) return; sdi[j] = dist; q.push_back(j); };
+      auto visit = [&] (int j, int dist) { if(sdi[j] < unseen) return; sdi[j] = dist; q.push_back(j); };
       visit(i, 0);
       for(int j=0; j<isize(q); j++) for(int k: neighbors[q[j]]) visit(k, sdi[q[j]]+1);
-      }
+      }, true);
+    sagdist.unreachable = min(N, 65535);
     }
   
-  max_sag_dist = 0;
-  for(auto x: sagdist) max_sag_dist = max<int>(max_sag_dist, x);
-  max_sag_dist++;
-  if(debug_init_sag)
-    println(hlog, "max_sag_dist = ", max_sag_dist);
+  compute_max_sag_dist();
   }
 
 bool legacy;
@@ -374,16 +624,21 @@ void compute_creq_neighbors() {
   int SN = isize(sagcells);
   neighbors.resize(SN);
   vector<int> mindist_for(SN, 30000);
+  max_sag_dist = 0;
   for(int i=0; i<SN; i++) {
     auto& m = mindist_for[i];
-    for(int j=0; j<SN; j++) if(j != i) m = min<int>(m, sagdist[i][j]);
+    auto row = sagdist[i];
+    for(int j=0; j<SN; j++) {
+      if(j != i) m = min<int>(m, row[j]);
+      max_sag_dist = max<int>(max_sag_dist, row[j]);
+      }
     }
 
-  for(int i=0; i<SN; i++)
-  for(int j=0; j<SN; j++) if(i != j && sagdist[i][j] < mindist_for[i] + mindist_for[j]) neighbors[i].push_back(j);
+  for(int i=0; i<SN; i++) {
+    auto row = sagdist[i];
+    for(int j=0; j<SN; j++) if(i != j && row[j] < mindist_for[i] + mindist_for[j]) neighbors[i].push_back(j);
+    }
 
-  max_sag_dist = 0;
-  for(auto x: sagdist) max_sag_dist = max<int>(max_sag_dist, x);
   max_sag_dist++;
   if(debug_init_sag)
     println(hlog, "the neighors of 0 are ", neighbors[0]);
@@ -493,52 +748,42 @@ void init_cell_request() {
     }
 
   int SN = isize(sagcells);
-  sagdist.init(SN, 0);
 
   if(!dijkstra_maxedge) {
     DEBBI(debug_init_sag, ("computing sagdist ..."));
-    parallelize(SN, [&] (int a, int b) {
-      for(int i=a; i<b; i++) {
-        for(int j=0; j<SN; j++) {
-          ld dist = pdist(sagsubcell_point[i], sagsubcell_point[j]);
-          sagdist[i][j] = int(dist * gdist_prec + 0.5);
-          if(i < j && sagdist[i][j] == 0 && debug_sag_cells)
-            println(hlog, "for ", tie(i,j), " pdist computed as ", dist);
-          }
+    sagdist.set_rows(SN, [SN] (int i, sagdist_t::distance *row) {
+      for(int j=0; j<SN; j++) {
+        ld dist = pdist(sagsubcell_point[i], sagsubcell_point[j]);
+        row[j] = int(dist * gdist_prec + 0.5);
+        if(i < j && row[j] == 0 && debug_sag_cells)
+          println(hlog, "for ", tie(i,j), " pdist computed as ", dist);
         }
-      return 0;
-      });
+      }, true);
     }
   else {
-    vector<vector<pair<ld, int>>> dijkstra_edges_2;
-    dijkstra_edges_2.resize(SN);
-    for(int i=0; i<SN; i++) for(auto p: dijkstra_edges[i]) if(ids.count(p.second)) dijkstra_edges_2[i].emplace_back(p.first, ids[p.second]);
-
-    parallelize(SN, [&] (int a, int b) {
-      vector<ld> distances(SN);
-      for(int i=a; i<b; i++) {
-        if(debug_progress && i % 500 == 0) println(hlog, "computing dijkstra for ", i , "/", SN);
-        for(int j=0; j<SN; j++) distances[j] = HUGE_VAL;
-        std::priority_queue<pair<ld, int>> pq;
-        auto visit = [&] (int i, ld dist) {
-          if(distances[i] <= dist) return;
-          distances[i] = dist;
-          pq.emplace(-dist, i);
-          };
-        visit(i, 0);
-        while(!pq.empty()) {
-          ld d = -pq.top().first;
-          int at = pq.top().second;
-          pq.pop();
-          for(auto e: dijkstra_edges_2[at]) {
-            // println(hlog, "move from ", at, " to ", e.first, " for ", d, "+", e.second);
-            visit(e.second, d + e.first);
-            }
+    auto dijkstra_edges_2 = std::make_shared<vector<vector<pair<ld, int>>>>(SN);
+    for(int i=0; i<SN; i++) for(auto p: dijkstra_edges[i]) if(ids.count(p.second)) (*dijkstra_edges_2)[i].emplace_back(p.first, ids[p.second]);
+
+    sagdist.set_rows(SN, [SN, dijkstra_edges_2] (int i, sagdist_t::distance *row) {
+      vector<ld> distances(SN, HUGE_VAL);
+      std::priority_queue<pair<ld, int>> pq;
+      auto visit = [&] (int i, ld dist) {
+        if(distances[i] <= dist) return;
+        distances[i] = dist;
+        pq.emplace(-dist, i);
+        };
+      visit(i, 0);
+      while(!pq.empty()) {
+        ld d = -pq.top().first;
+        int at = pq.top().second;
+        pq.pop();
+        for(auto e: (*dijkstra_edges_2)[at]) {
+          // println(hlog, "move from ", at, " to ", e.first, " for ", d, "+", e.second);
+          visit(e.second, d + e.first);
           }
-        for(int j=0; j<SN; j++) sagdist[i][j] = distances[j] * gdist_prec + .5;
         }
-      return 0;
-      });
+      for(int j=0; j<SN; j++) row[j] = distances[j] == HUGE_VAL ? 65535 : distances[j] * gdist_prec + .5;
+      }, true);
     }
 
   compute_creq_neighbors();
@@ -605,7 +850,7 @@ void geo_stats() {
 
   println(hlog, "counting sagdist, N=", int(sagdist.N), " max_sag_dist = ", max_sag_dist);
   vector<short> sgdc(max_sag_dist, 0);
-  for(auto x: sagdist) sgdc[x]++;
+  sagdist.for_all([&] (int x) { sgdc[x]++; });
 
   println(hlog, "building sorted_sagdist");
   vector<short> sorted_sagdist;
@@ -673,6 +918,17 @@ int cell_read_args() {
     shift();
     sagdist.save(args());
     }
+  #if CAP_ZLIB
+  else if(argis("-sag_gdist_save_tiled")) {
+    init_cells();
+    shift();
+    sagdist.save_tiled(args());
+    }
+  #endif
+  else if(argis("-sag-ondemand")) {
+    shift(); sag_row_cache_mb = argi();
+    sag_on_demand = sag_row_cache_mb > 0;
+    }
   else if(argis("-sag_gdist_load")) {
     distance_only = false;
     shift(); distance_file = args();
@@ -32,25 +32,27 @@ debugflag debug_opt("sag_opt");
 
 bool should_good = false;
 
-double costat(int vid, int sid) {
+/** the cost of node vid placed at subcell sid, in the placement given by ids (like sagid) and nodes (like sagnode);
+ *  only reads the shared tables, so separate placements can be evaluated in parallel */
+double costat(const vector<int>& ids, const vector<int>& nodes, int vid, int sid) {
   if(vid < 0) return 0;
   double cost = 0;
 
   switch(method) {
     case smLogistic: {
       auto s = sagdist[sid];
-      for(auto j: edges_yes[vid]) if(sagid[j] >= -1)
-        cost += loglik_tab_y[s[sagid[j]]];
-      for(auto j: edges_no[vid]) if(sagid[j] >= -1)
-        cost += loglik_tab_n[s[sagid[j]]];
+      for(auto j: edges_yes[vid]) if(ids[j] >= -1)
+        cost += loglik_tab_y[s[ids[j]]];
+      for(auto j: edges_no[vid]) if(ids[j] >= -1)
+        cost += loglik_tab_n[s[ids[j]]];
       return -cost;
       }
 
     case smMatch: {
       for(auto& e: edge_weights[vid]) {
         auto t2 = e.first;
-        if(sagid[t2] != -1) {
-          ld cdist = sagdist[sid][sagid[t2]];
+        if(ids[t2] != -1) {
+          ld cdist = sagdist[sid][ids[t2]];
           ld expect = match_a / e.second + match_b;
           ld dist = cdist - expect;
           cost += dist * dist;
@@ -62,12 +64,12 @@ double costat(int vid, int sid) {
     case smClosest: {
       for(auto& e: edge_weights[vid]) {
         auto t2 = e.first;
-        if(sagid[t2] != -1) cost += sagdist[sid][sagid[t2]] * e.second;
+        if(ids[t2] != -1) cost += sagdist[sid][ids[t2]] * e.second;
         }
       
       if(!hubval.empty()) {
         for(auto sid2: neighbors[sid]) {
-          int vid2 = sagnode[sid2];
+          int vid2 = nodes[sid2];
           if(vid2 >= 0 && (hubval[vid] & hubval[vid]) == 0)
             cost += hub_penalty;
           }
@@ -80,6 +82,8 @@ double costat(int vid, int sid) {
   throw hr_exception("unknwon SAG method");
   }
 
+double costat(int vid, int sid) { return costat(sagid, sagnode, vid, sid); }
+
 double cost;
 
 double best_cost = 1000000000;
@@ -104,11 +108,11 @@ void compute_loglik_tab() {
 void compute_auto_rt() {
   ld sum0 = 0, sum1 = 0, sum2 = 0;
 
-  for(auto i: sagdist) {
+  sagdist.for_all([&] (ld i) {
     sum0 ++;
     sum1 += i;
     sum2 += i*i;
-    }
+    });
 
   lgsag.R = sum1 / sum0;
   lgsag.T = sqrt((sum2 - sum1*sum1/sum0) / sum0);
@@ -87,6 +87,16 @@ double vnorm(kohvec& a, kohvec& b) {
   return diff;
   }
 
+/** vnorm, but gives up as soon as the partial sum exceeds limit (the result is then only known to be > limit) */
+double vnorm_bounded(const kohvec& a, const kohvec& b, double limit) {
+  double diff = 0;
+  for(int k=0; k<columns; k++) {
+    diff += sqr((a[k]-b[k]) * weights[k]);
+    if((k & 7) == 7 && diff > limit) return diff;
+    }
+  return diff;
+  }
+
 bool noshow = false;
 
 vector<int> samples_to_show;
@@ -131,14 +141,33 @@ double learning_factor = .1;
 int t, lpct, cells;
 double maxdist;
 
+/** use the partial-distance early exit when looking for the best matching unit */
+bool partial_distance = true;
+
+/** the neuron which won for each sample the last time, tried first by winner() */
+vector<int> last_winner;
+
 neuron& winner(int id) {
   double bdiff = HUGE_VAL;
-  neuron *bcell = NULL;
-  for(neuron& n: net) {
-    double diff = vnorm(n.net, data[id].val);
-    if(diff < bdiff) bdiff = diff, bcell = &n;
+  int best = -1;
+  if(!partial_distance) {
+    for(int i=0; i<cells; i++) {
+      double diff = vnorm(net[i].net, data[id].val);
+      if(diff < bdiff) bdiff = diff, best = i;
+      }
+    return net[best];
+    }
+  /* the result is the same as above: the first neuron with the smallest distance */
+  last_winner.resize(samples, -1);
+  int guess = last_winner[id];
+  if(guess >= cells) guess = -1;
+  if(guess >= 0) best = guess, bdiff = vnorm(net[guess].net, data[id].val);
+  for(int i=0; i<cells; i++) if(i != guess) {
+    double diff = vnorm_bounded(net[i].net, data[id].val, bdiff);
+    if(diff < bdiff || (diff == bdiff && i < best)) bdiff = diff, best = i;
     }
-  return *bcell;
+  last_winner[id] = best;
+  return net[best];
   }
 
 void setindex(bool b) {
@@ -863,9 +892,13 @@ void create_neurons() {
   DEBB(debug_kohonen, ("number of neurons = ", cells));
   }
 
+/** random seed for the initial neurons and the training samples; -1 to keep the current random state */
+int som_seed = -1;
+
 void set_neuron_initial() {
   initialize_neurons();
   DEBBI(debug_kohonen, ("Setting initial neuron values"));
+  if(som_seed >= 0) shrand(som_seed);
   for(int i=0; i<cells; i++) {
     alloc(net[i].net);
     for(int k=0; k<columns; k++)
@@ -1229,22 +1262,154 @@ template<class T> void load_raw(string fname, vector<T>& v) {
   fclose(f);
   }
 
+/** \brief the neurons, multiplied by the column weights, as one row-major matrix
+ *
+ *  The squared Euclidean distance between a row and a weighted sample is vnorm of the neuron and the sample.
+ *  It is a snapshot: build() it again whenever the neurons change.
+ */
+struct neuron_matrix {
+  int rows = 0, cols = 0;
+  vector<double> w;
+
+  void build() {
+    rows = cells; cols = columns;
+    w.resize(size_t(rows) * cols);
+    for(int i=0; i<rows; i++)
+    for(int k=0; k<cols; k++)
+      w[size_t(i) * cols + k] = net[i].net[k] * weights[k];
+    }
+
+  const double *row(int i) const { return &w[size_t(i) * cols]; }
+
+  void weigh(const kohvec& v, double *q) const {
+    for(int k=0; k<cols; k++) q[k] = v[k] * weights[k];
+    }
+
+  /** the best matching unit for the weighted vector q, trying guess first; ties go to the lowest index, as in winner() */
+  int best(const double *q, int guess, double& bdiff) const {
+    bdiff = HUGE_VAL;
+    int best = -1;
+    if(guess >= 0 && guess < rows)
+      best = guess, bdiff = batch_ops->row_sqdist(row(guess), q, cols, HUGE_VAL);
+    for(int i=0; i<rows; i++) if(i != guess) {
+      double diff = batch_ops->row_sqdist(row(i), q, cols, partial_distance ? bdiff : HUGE_VAL);
+      if(diff < bdiff || (diff == bdiff && i < best)) bdiff = diff, best = i;
+      }
+    return best;
+    }
+  };
+
+/** find the best matching units for all samples, on worker_threads threads; bid may contain the guesses from the last call */
+void classify_all(const neuron_matrix& m, vector<int>& bid, vector<double>& bdiff) {
+  bid.resize(samples, -1);
+  bdiff.resize(samples);
+  const int block = 8192;
+  for(int s0=0; s0<samples; s0+=block) {
+    int s1 = min(s0 + block, samples);
+    parallel_for(s1 - s0, [&] (int a, int b) {
+      vector<double> q(columns);
+      for(int s=s0+a; s<s0+b; s++) {
+        m.weigh(data[s].val, &q[0]);
+        bid[s] = m.best(&q[0], bid[s], bdiff[s]);
+        }
+      });
+    progress("Classifying: " + its(s1) + "/" + its(samples));
+    }
+  }
+
+/** \brief batch SOM training
+ *
+ *  Every epoch classifies all the samples (in parallel), and then sets every neuron to the mean of the samples,
+ *  weighted by the neighborhood function of their winners -- the same one as step() uses at the same fraction
+ *  of the run. The result does not depend on the number of threads.
+ */
+void batch_train(int epochs) {
+  initialize_dispersion();
+  initialize_neurons_initial();
+
+  neuron_matrix m;
+  vector<int> bid;
+  vector<double> bdiff, sums, numer, denom;
+  vector<int> counts;
+  vector<pair<int, double>> targets;
+
+  for(int e=epochs; e>0; e--) {
+    double tt = pow((e-.5) / epochs, ttpower);
+    double sigma = maxdist * tt;
+
+    m.build();
+    classify_all(m, bid, bdiff);
+
+    sums.assign(size_t(cells) * columns, 0);
+    counts.assign(cells, 0);
+    for(int s=0; s<samples; s++) {
+      counts[bid[s]]++;
+      double *row = &sums[size_t(bid[s]) * columns];
+      for(int k=0; k<columns; k++) row[k] += data[s].val[k];
+      }
+
+    numer.assign(size_t(cells) * columns, 0);
+    denom.assign(cells, 0);
+    for(int b=0; b<cells; b++) if(counts[b]) {
+      neuron& n = net[b];
+      auto cid = get_cellcrawler_id(n.where);
+      cellcrawler& s = scc[cid.first];
+      s.sprawl(cellwalker(n.where, cid.second));
+
+      int dispid = int(isize(s.dispersion) * tt);
+      targets.clear();
+      for(int i=0; i<isize(s.data); i++) {
+        auto& sd = s.data[i];
+        neuron *n2 = getNeuron(sd.target.at);
+        if(!n2) continue;
+        double nu = gaussian ? exp(-sqr(sd.dist/sigma)) : s.dispersion[dispid][i];
+        if(isnan(nu))
+          throw hr_exception(lalign(0, "obtained nan, ", sd.dist, " / ", sigma));
+        if(nu) targets.emplace_back(neuronId(*n2), nu);
+        }
+
+      /* every neuron appears at most once in targets, so the rows can be updated in parallel */
+      const double *src = &sums[size_t(b) * columns];
+      int cnt = counts[b];
+      parallel_for(isize(targets), [&] (int a, int z) {
+        for(int i=a; i<z; i++) {
+          int id = targets[i].first;
+          double nu = targets[i].second;
+          double *dst = &numer[size_t(id) * columns];
+          for(int k=0; k<columns; k++) dst[k] += nu * src[k];
+          denom[id] += nu * cnt;
+          }
+        });
+      }
+
+    for(int i=0; i<cells; i++) if(denom[i] > 0)
+      for(int k=0; k<columns; k++) net[i].net[k] = numer[size_t(i) * columns + k] / denom[i];
+
+    double qerror = 0;
+    for(double d: bdiff) qerror += d;
+    if(debug_kohonen)
+      println(hlog, "batch epoch ", epochs-e+1, "/", epochs, ": sigma = ", sigma, " quantization error = ", qerror / samples);
+    }
+
+  setindex(false);
+  bids.clear(); bdiffs.clear(); bdiffn.clear();
+  t = 0;
+  analyze();
+  }
+
 bool groupsizes_known = false;
 
 void do_classify() {
   initialize_neurons_initial();
   if(bids.empty()) {
     printf("Classifying...\n");
-    bids.resize(samples, 0);
-    bdiffs.resize(samples, 1e20);
-    for(int s=0; s<samples; s++) {
-      for(int n=0; n<cells; n++) {
-        double diff = vnorm(net[n].net, data[s].val);
-        if(diff < bdiffs[s]) bdiffs[s] = diff, bids[s] = n, whowon[s] = &net[n];
-        }
-      if(!(s % 128))
-        progress("Classifying: " + its(s) + "/" + its(samples));
-      }
+    neuron_matrix m;
+    m.build();
+    vector<int> bid;
+    classify_all(m, bid, bdiffs);
+    bids.resize(samples);
+    whowon.resize(samples);
+    for(int s=0; s<samples; s++) bids[s] = bid[s], whowon[s] = &net[bid[s]];
     }
   if(bdiffs.empty()) {
     printf("Computing distances...\n");
@@ -1795,6 +1960,19 @@ int readArgs() {
       kohonen::step();
       }
     }
+  else if(argis("-som-batch")) {
+    // batch training from fresh neurons; uses worker_threads
+    shift(); int epochs = argi();
+    initialize_rv();
+    set_neuron_initial();
+    batch_train(epochs);
+    }
+  else if(argis("-som-seed")) {
+    shift(); som_seed = argi();
+    }
+  else if(argis("-som-pds")) {
+    shift(); partial_distance = argi();
+    }
   else if(argis("-somstop")) {
     t = 0;
     }
@@ -1954,6 +2132,7 @@ void clear() {
   bdiffs.clear();
   bids.clear();
   bdiffn.clear();
+  last_winner.clear();
   state = 0;
   }
 
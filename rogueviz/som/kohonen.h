@@ -73,6 +73,7 @@ void clear();
 void create_neurons();
 void analyze();
 void step();
+void batch_train(int epochs);
 void initialize_rv();
 void set_neuron_initial();
 bool finished();
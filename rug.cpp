@@ -131,6 +131,9 @@ EX ld err_zero = 1e-3, err_zero_current, current_total_error;
 
 EX int queueiter, qvalid, dt;
 
+/** set whenever the positions or edges of points change outside of the sweep engine */
+bool sweeps_dirty = true;
+
 EX rugpoint *finger_center;
 EX ld finger_range = .1;
 EX ld finger_force = 1;
@@ -153,6 +156,7 @@ EX void push_all_points(int coord, ld val) {
   if(!val) return;
   else for(int i=0; i<isize(points); i++)
     push_point(points[i]->native, coord, val);
+  sweeps_dirty = true;
   }
 
 // construct the graph
@@ -167,6 +171,84 @@ bool rug_elliptic() { USING_NATIVE_GEOMETRY; return elliptic; }
 
 EX map<cell*, rugpoint*> rug_map;
 
+/** use rugpoint_index in findRugpoint (otherwise all the points are compared) */
+EX bool use_point_index = true;
+
+/** \brief a spatial index over points, used by findRugpoint
+ *
+ *  Points are bucketed by their projective coordinates (h/h[LDIM], or h/|h| on the sphere),
+ *  in which nearby points stay nearby (distances do not grow). A point within the matching
+ *  distance is thus either in the same bucket or, if close to a bucket boundary, in the
+ *  neighboring one. Loaded rugs (rug_load) have no tiling coordinates and are not indexed.
+ */
+struct rugpoint_index {
+  static constexpr ld cellsize = 1e-3;
+  static constexpr ld tolerance = 1e-5;
+  std::unordered_map<buckethash_t, vector<rugpoint*>> buckets;
+  /** false if some point could not be indexed, in which case findRugpoint compares all the points */
+  bool usable = true;
+
+  static bool applicable() {
+    return !sl2 && !elliptic && !gproduct && !nonisotropic && (hyperbolic || euclid || sphere);
+    }
+
+  static hyperpoint key_point(const shiftpoint& h) {
+    hyperpoint k = h.h;
+    ld z = sphere ? sqrt(sqhypot_d(MDIM, k)) : k[LDIM];
+    for(int i=0; i<MDIM; i++) k[i] /= z;
+    return k;
+    }
+
+  /** \brief call f for the buckets which may contain points close to k; only the bucket of k if exact */
+  template<class T> static void for_buckets(const hyperpoint& k, bool exact, const T& f) {
+    array<long long, 4> q, alt;
+    array<int, 4> dirs;
+    for(int i=0; i<MDIM; i++) {
+      ld v = k[i] / cellsize;
+      q[i] = (long long) floor(v);
+      ld fr = v - q[i];
+      dirs[i] = exact ? 0 : fr < tolerance / cellsize ? -1 : fr > 1 - tolerance / cellsize ? 1 : 0;
+      }
+    for(int mask=0; mask < (1<<MDIM); mask++) {
+      bool ok = true;
+      for(int i=0; i<MDIM; i++) {
+        if(mask & (1<<i)) { if(!dirs[i]) { ok = false; break; } alt[i] = q[i] + dirs[i]; }
+        else alt[i] = q[i];
+        }
+      if(!ok) continue;
+      buckethash_t b = 0;
+      for(int i=0; i<MDIM; i++) hashmix(b, alt[i]);
+      f(b);
+      }
+    }
+
+  void clear() { buckets.clear(); usable = true; }
+
+  void add(rugpoint *m) {
+    if(!usable) return;
+    if(!applicable() || m->h.shift) { usable = false; buckets.clear(); return; }
+    for_buckets(key_point(m->h), true, [&] (buckethash_t b) { buckets[b].push_back(m); });
+    }
+
+  /** \brief find a point close to h; returns false if the index cannot be used */
+  bool find(const shiftpoint& h, rugpoint*& res) {
+    if(!usable || !applicable() || h.shift) return false;
+    res = nullptr;
+    hyperpoint k = key_point(h);
+    for_buckets(k, false, [&] (buckethash_t b) {
+      if(res) return;
+      auto it = buckets.find(b);
+      if(it == buckets.end()) return;
+      USING_NATIVE_GEOMETRY;
+      for(auto p: it->second)
+        if(geo_dist_q(p->h.h, unshift(h, p->h.shift)) < 1e-5) { res = p; return; }
+      });
+    return true;
+    }
+  };
+
+rugpoint_index point_index;
+
 EX rugpoint *addRugpoint(shiftpoint h, double dist) {
   rugpoint *m = new rugpoint;
   m->h = h;
@@ -267,10 +349,13 @@ EX rugpoint *addRugpoint(shiftpoint h, double dist) {
   m->inqueue = false;
   m->dist = dist;
   points.push_back(m);
+  point_index.add(m);
   return m;
   }
 
 EX rugpoint *findRugpoint(shiftpoint h) {
+  rugpoint *res;
+  if(use_point_index && point_index.find(h, res)) return res;
   USING_NATIVE_GEOMETRY;
   for(int i=0; i<isize(points); i++) 
     if(geo_dist_q(points[i]->h.h, unshift(h, points[i]->h.shift)) < 1e-5) return points[i];
@@ -631,59 +716,65 @@ EX void buildRug() {
 queue<rugpoint*> pqueue;
 
 EX void enqueue(rugpoint *m) {
+  sweeps_dirty = true;
   if(m->inqueue) return;
   pqueue.push(m);
   m->inqueue = true;
   }
 
-bool force_euclidean(rugpoint& m1, rugpoint& m2, double rd, bool is_anticusp = false, double d1=1, double d2=1) {
-  if(!m1.valid || !m2.valid) return false;
-  USING_NATIVE_GEOMETRY;
-  // double rd = geo_dist_q(m1.h, m2.h) * xd;
-  double t = sqhypot_d(3, m1.native - m2.native);
-  if(is_anticusp && t > rd*rd) return false;
-  t = sqrt(t);
-  current_total_error += (t-rd) * (t-rd);
-  bool nonzero = abs(t-rd) > err_zero_current;
-  double force = (t - rd) / t / 2; // 20.0;
-  for(int i=0; i<3; i++) {
-    double di = (m2.native[i] - m1.native[i]) * force;
-    m1.native[i] += di * d1;
-    m2.native[i] -= di * d2;
-    if(nonzero && d2>0) enqueue(&m2);
-    }  
-  return nonzero;
-  }
-
-bool force(rugpoint& m1, rugpoint& m2, double rd, bool is_anticusp=false, double d1=1, double d2=1) {
-  if(!m1.valid || !m2.valid) return false;
-  if(rug_euclid() && fast_euclidean) {
-    return force_euclidean(m1, m2, rd, is_anticusp, d1, d2);
+/** the common part of force(): move h1 and h2 towards each other (or apart) so that their
+ *  distance gets closer to rd; d1 and d2 say how much of the correction each endpoint takes.
+ *  The caller must switch to the native geometry. Adds the squared error to error, and
+ *  returns 0 for an inactive anticusp edge, 1 if the edge is within err_zero_current,
+ *  2 if the points have been moved, and -1 if h1 is not a number.
+ *  Touches no global state, so it can be called from worker threads.
+ */
+int edge_step(hyperpoint& h1, hyperpoint& h2, ld rd, bool is_anticusp, ld d1, ld d2, bool fast, ld& error) {
+  if(fast) {
+    double t = sqhypot_d(3, h1 - h2);
+    if(is_anticusp && t > rd*rd) return 0;
+    t = sqrt(t);
+    error += (t-rd) * (t-rd);
+    bool nonzero = abs(t-rd) > err_zero_current;
+    double force = (t - rd) / t / 2; // 20.0;
+    for(int i=0; i<3; i++) {
+      double di = (h2[i] - h1[i]) * force;
+      h1[i] += di * d1;
+      h2[i] -= di * d2;
+      }
+    return nonzero ? 2 : 1;
     }
-  USING_NATIVE_GEOMETRY;
-  
-  ld t = geo_dist_q(m1.native, m2.native);
-  if(is_anticusp && t > rd) return false;
-  current_total_error += (t-rd) * (t-rd);
+
+  ld t = geo_dist_q(h1, h2);
+  if(is_anticusp && t > rd) return 0;
+  error += (t-rd) * (t-rd);
   bool nonzero = abs(t-rd) > err_zero_current;
   double forcev = (t - rd) / 2; // 20.0;
   
-  transmatrix T = iso_inverse(rgpushxto0(m1.native));
-  hyperpoint ie = inverse_exp(shiftless(T * m2.native));
+  transmatrix T = iso_inverse(rgpushxto0(h1));
+  hyperpoint ie = inverse_exp(shiftless(T * h2));
 
-  transmatrix iT = rgpushxto0(m1.native);
+  transmatrix iT = rgpushxto0(h1);
   
-  for(int i=0; i<MXDIM; i++) if(std::isnan(m1.native[i])) { 
+  for(int i=0; i<MXDIM; i++) if(std::isnan(h1[i])) return -1;
+
+  h1 = iT * direct_exp(ie * (d1*forcev/t));
+  if(d2) h2 = iT * direct_exp(ie * ((t-d2*forcev)/t));
+  return nonzero ? 2 : 1;
+  }
+
+bool force(rugpoint& m1, rugpoint& m2, double rd, bool is_anticusp=false, double d1=1, double d2=1) {
+  if(!m1.valid || !m2.valid) return false;
+  bool fast = rug_euclid() && fast_euclidean;
+  USING_NATIVE_GEOMETRY;
+  int res = edge_step(m1.native, m2.native, rd, is_anticusp, d1, d2, fast, current_total_error);
+  if(res < 0) {
     addMessage("Failed!");
     println(hlog, "m1 = ", m1.native);
     throw rug_exception();
     }
-
-  m1.native = iT * direct_exp(ie * (d1*forcev/t));
-  m2.native = iT * direct_exp(ie * ((t-d2*forcev)/t));
-
-  if(nonzero && d2>0) enqueue(&m2);
-  return nonzero;
+  if(res == 2 && d2>0) enqueue(&m2);
+  return res == 2;
   }
 
 vector<pair<ld, rugpoint*> > preset_points;
@@ -975,6 +1066,175 @@ EX void addNewPoints() {
   if(qvalid != oqvalid) { println(hlog, "adding new points ", make_tuple(oqvalid, qvalid, isize(points), dist, dt, queueiter)); }
   }
 
+#if HDR
+/** what happened during one sweep of the relaxation engine */
+struct sweep_report {
+  int sweep;
+  int updated; /**< edges relaxed */
+  int moving;  /**< points moved by more than err_zero_current */
+  ld error;
+  };
+#endif
+
+/** use the sweep engine instead of the queue when the rug has at least this many points; -1 (default) to never use it */
+EX int sweep_min_points = -1;
+
+/** print a sweep_report after every sweep */
+EX bool sweep_log = false;
+
+EX sweep_report last_sweep;
+
+/** \brief edge-coloured Gauss-Seidel relaxation of the rug
+ *
+ *  The valid points and their edges (anticusp edges included) are copied into flat
+ *  arrays, and the edges are ordered by a greedy edge colouring. Edges of one colour
+ *  share no endpoints, so every colour is relaxed with parallel_for, each edge applying
+ *  exactly the step of force(). An edge is only relaxed again if one of its endpoints
+ *  has moved, which mimics the queue of the serial engine.
+ *  The positions are copied back to the rugpoints by publish(), so the renderer never
+ *  sees a half-finished sweep.
+ */
+struct sweep_engine {
+  vector<rugpoint*> source;
+  vector<hyperpoint> pos;
+  vector<int> edge_a, edge_b;
+  vector<ld> edge_len, edge_error;
+  vector<char> edge_anticusp, edge_updated;
+  vector<int> colour_start;
+  vector<char> moved, moved_before, failed;
+  bool fast, parallel;
+  int sweeps = 0;
+
+  void clear() { source.clear(); pos.clear(); sweeps = 0; }
+  void build();
+  void relax(int e);
+  const sweep_report& sweep();
+  void publish();
+  };
+
+sweep_engine sweeps;
+
+void sweep_engine::build() {
+  /* the sweeps replace the queue */
+  while(!pqueue.empty()) pqueue.front()->inqueue = false, pqueue.pop();
+
+  fast = rug_euclid() && fast_euclidean;
+  {
+  USING_NATIVE_GEOMETRY;
+  parallel = !nonisotropic && !mproduct;
+  }
+
+  map<rugpoint*, int> index;
+  source.clear(); pos.clear();
+  for(auto p: points) if(p->valid) index[p] = isize(source), source.push_back(p), pos.push_back(p->native);
+  int N = isize(source);
+
+  struct rug_edge { int a, b; ld len; bool anticusp; };
+  vector<rug_edge> edges;
+  for(int i=0; i<N; i++) {
+    for(auto& e: source[i]->edges) if(e.target->valid && index[e.target] > i)
+      edges.push_back({i, index[e.target], e.len, false});
+    for(auto& e: source[i]->anticusp_edges) if(e.target->valid && index[e.target] > i)
+      edges.push_back({i, index[e.target], anticusp_dist, true});
+    }
+  int E = isize(edges);
+
+  /* greedy edge colouring: the smallest colour not used at either endpoint */
+  vector<vector<char>> used(N);
+  vector<int> colour(E);
+  int colours = 0;
+  for(int e=0; e<E; e++) {
+    auto& ua = used[edges[e].a];
+    auto& ub = used[edges[e].b];
+    int c = 0;
+    while((c < isize(ua) && ua[c]) || (c < isize(ub) && ub[c])) c++;
+    if(c >= isize(ua)) ua.resize(c+1);
+    if(c >= isize(ub)) ub.resize(c+1);
+    ua[c] = ub[c] = true;
+    colour[e] = c; colours = max(colours, c+1);
+    }
+
+  colour_start.assign(colours+1, 0);
+  for(int e=0; e<E; e++) colour_start[colour[e]+1]++;
+  for(int c=0; c<colours; c++) colour_start[c+1] += colour_start[c];
+  vector<int> at(colour_start.begin(), colour_start.end()-1);
+
+  edge_a.resize(E); edge_b.resize(E); edge_len.resize(E); edge_anticusp.resize(E);
+  for(int e=0; e<E; e++) {
+    int i = at[colour[e]]++;
+    edge_a[i] = edges[e].a; edge_b[i] = edges[e].b;
+    edge_len[i] = edges[e].len; edge_anticusp[i] = edges[e].anticusp;
+    }
+
+  edge_error.assign(E, 0); edge_updated.assign(E, 0);
+  moved.assign(N, 0); moved_before.assign(N, 1); failed.assign(N, 0);
+  println(hlog, "sweep engine: ", N, " points, ", E, " edges, ", colours, " colours");
+  }
+
+void sweep_engine::relax(int e) {
+  int a = edge_a[e], b = edge_b[e];
+  if(!moved_before[a] && !moved_before[b] && !moved[a] && !moved[b]) return;
+  edge_updated[e] = true;
+  ld err = 0;
+  int res = edge_step(pos[a], pos[b], edge_len[e], edge_anticusp[e], 1, 1, fast, err);
+  if(res < 0) { failed[a] = true; return; }
+  edge_error[e] = err;
+  if(res == 2) moved[a] = moved[b] = true;
+  }
+
+const sweep_report& sweep_engine::sweep() {
+  USING_NATIVE_GEOMETRY;
+  for(int c=0; c+1<isize(colour_start); c++) {
+    int first = colour_start[c];
+    auto act = [this, first] (int a, int b) { for(int e=first+a; e<first+b; e++) relax(e); };
+    if(parallel) parallel_for(colour_start[c+1] - first, act);
+    else act(0, colour_start[c+1] - first);
+    }
+
+  auto& r = last_sweep;
+  r.sweep = ++sweeps;
+  r.updated = r.moving = 0; r.error = 0;
+  for(int i=0; i<isize(pos); i++) {
+    if(failed[i]) {
+      addMessage("Failed!");
+      println(hlog, "m1 = ", pos[i]);
+      throw rug_exception();
+      }
+    if(moved[i]) r.moving++;
+    }
+  for(int e=0; e<isize(edge_error); e++) {
+    r.error += edge_error[e];
+    if(edge_updated[e]) r.updated++, edge_updated[e] = false;
+    }
+  swap(moved, moved_before);
+  for(auto& m: moved) m = false;
+  queueiter += r.updated;
+  current_total_error = r.error;
+  if(sweep_log) println(hlog, "sweep ", r.sweep, ": ", r.moving, " points moved, ", r.updated, " edges relaxed, error ", fts(r.error));
+  return r;
+  }
+
+void sweep_engine::publish() {
+  for(int i=0; i<isize(pos); i++) source[i]->native = pos[i];
+  }
+
+EX bool use_sweeps() {
+  return sweep_min_points >= 0 && isize(points) >= sweep_min_points;
+  }
+
+void sweep_physics() {
+  auto t = SDL_GetTicks();
+  bool moving = false;
+  while(SDL_GetTicks() < t + 5 && !stop) {
+    if(sweeps_dirty) sweeps.build(), sweeps_dirty = false;
+    if(sweeps.sweep().moving) { moving = true; continue; }
+    sweeps.publish();
+    addNewPoints();
+    }
+  sweeps.publish();
+  if(moving) need_mouseh = true;
+  }
+
 EX void physics() {
 
   #if CAP_CRYSTAL && MAXMDIM >= 4
@@ -988,6 +1248,11 @@ EX void physics() {
 
   auto t = SDL_GetTicks();
   
+  if(use_sweeps()) {
+    sweep_physics();
+    return;
+    }
+  
   current_total_error = 0;
   
   while(SDL_GetTicks() < t + 5 && !stop)
@@ -1188,6 +1453,26 @@ EX void reopen() {
 
 EX bool display_warning = true;
 
+/** \brief build rugs for vertex limits 1000, 2000, ... up to maxlimit, and report the times */
+EX void build_benchmark(int maxlimit) {
+  dynamicval<int> dv(vertex_limit, vertex_limit);
+  for(int lim=1000; lim<=maxlimit; lim*=2) {
+    vertex_limit = lim;
+    clear_model();
+    genrug = true;
+    drawthemap();
+    genrug = false;
+    qvalid = 0; err_zero_current = err_zero;
+    divides = 0; precision_increases = 0;
+    auto start = std::chrono::steady_clock::now();
+    buildRug();
+    while(good_shape && subdivide_further()) subdivide();
+    ld secs = std::chrono::duration<ld>(std::chrono::steady_clock::now() - start).count();
+    println(hlog, "rug build: vertex_limit ", lim, ": ", isize(points), " points, ", isize(triangles), " triangles in ", fts(secs), " s", use_point_index ? "" : " (no point index)");
+    }
+  clear_model();
+  }
+
 EX void init_model() {
   clear_model();
   genrug = true;
@@ -1256,7 +1541,10 @@ EX void clear_model() {
   for(int i=0; i<isize(points); i++) delete points[i];
   rug_map.clear();
   points.clear();
+  point_index.clear();
   pqueue = queue<rugpoint*> ();
+  sweeps.clear();
+  sweeps_dirty = true;
   }
   
 EX void close() {
@@ -1868,6 +2156,25 @@ int rugArgs() {
     shift(); rug_load(args());
     }
 
+  else if(argis("-rug-bench")) {
+    PHASE(3);
+    start_game();
+    calcparam();
+    shift(); build_benchmark(argi());
+    }
+
+  else if(argis("-rug-noindex")) {
+    use_point_index = false;
+    }
+
+  else if(argis("-rug-sweeps")) {
+    shift(); sweep_min_points = argi();
+    }
+
+  else if(argis("-rug-sweep-log")) {
+    sweep_log = true;
+    }
+
   else if(argis("-rugdist")) {
     shift_arg_formula(model_distance);
     }
@@ -1662,7 +1662,8 @@ void genhoneycomb(string fname) {
     }
   childpos.push_back(isize(data));
 
-  shstream ss;
+  fhstream of(fname, "wb");
+  zlib_output_hstream ss(of);
 
   ss.write(ss.get_vernum());
   mapstream::save_geometry(ss);
@@ -1685,11 +1686,7 @@ void genhoneycomb(string fname) {
   println(hlog, "childpos = ", childpos);
   hwrite(ss, childpos);
 
-  println(hlog, "compress_string");
-  string s = compress_string(ss.s);
-
-  fhstream of(fname, "wb");
-  print(of, s);
+  ss.finish();
   }
 
 EX void cleanup3() {
@@ -1729,7 +1726,14 @@ int readRuleArgs3() {
     stop_game();
     shift(); string s = arg::args();
     reg3::replace_rule_file = s;
-    shstream ins(decompress_string(read_file_as_string(s)));
+    #if ISANDROID || ISIOS
+    shstream f(get_asset(s));
+    #else
+    fhstream f(s, "rb");
+    if(!f.f) f.f = fopen((rsrcdir + s).c_str(), "rb");
+    if(!f.f) throw hstream_exception("cannot open " + s);
+    #endif
+    zlib_input_hstream ins(f);
     ins.read(ins.vernum);
     mapstream::load_geometry(ins);
     reg3::consider_rules = 2;
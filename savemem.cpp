@@ -50,6 +50,7 @@ void slow_delete_cell(cell *c) {
   }
 
 void delete_heptagon(heptagon *h2) {
+  ancestor_generation++;
   cell *c = h2->c7;
   if(BITRUNCATED) {
     for(int i=0; i<c->type; i++)
@@ -258,6 +259,12 @@ EX void show_memory_menu() {
     );
   
   if(cheater) dialog::addSelItem(XLAT("cells in memory"), its(cellcount) + "+" + its(heptacount), 0);
+
+  if(cheater) {
+    auto& tm = tailored_memory;
+    dialog::addSelItem(XLAT("cell allocator"), its(tm.live_bytes >> 10) + "/" + its(tm.reserved_bytes() >> 10) + " KB", 0);
+    dialog::addSelItem(XLAT("fragmentation"), fts(tm.fragmentation() * 100, 3) + "%, " + its(tm.reused) + "/" + its(tm.alloc_calls) + " reused", 0);
+    }
   
   dialog::addBoolItem(XLAT("memory saving mode"), memory_saving_mode, 'f');
   dialog::add_action([] { memory_saving_mode = !memory_saving_mode; if(memory_saving_mode) save_memory(), apply_memory_reserve(); });
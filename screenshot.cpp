@@ -709,10 +709,104 @@ EX SDL_Surface *empty_surface(int x, int y, bool alpha) {
 
 #if CAP_PNG
 
+/** \brief number of frames buffered between rendering and the video encoder; 0 writes them synchronously */
+EX int video_ring = 4;
+
+/** statistics of the last video recording */
+EX int frames_written;
+EX ld encoder_stall_ms;
+
+#if CAP_THREAD
+/** \brief a bounded ring of raw frames, written to rawfile_handle by a separate thread
+ *
+ *  The render thread only copies the frame into a free slot, so the next frame can be
+ *  rendered while the previous ones are written to the encoder. If the ring is full,
+ *  the render thread waits; this wait is reported as the encoder stall time.
+ */
+struct frame_ring {
+  vector<vector<color_t>> slots;
+  int head = 0, qty = 0;
+  bool finishing = false;
+  std::mutex lock;
+  std::condition_variable cv;
+  std::thread writer;
+
+  void start(int size) {
+    slots.resize(size);
+    head = 0; qty = 0; finishing = false;
+    writer = std::thread([this] { write_loop(); });
+    }
+
+  void write_loop() {
+    std::unique_lock<std::mutex> lk(lock);
+    while(true) {
+      cv.wait(lk, [this] { return qty > 0 || finishing; });
+      if(!qty) return;
+      auto& slot = slots[head];
+      lk.unlock();
+      ignore(write(rawfile_handle, slot.data(), slot.size() * sizeof(color_t)));
+      lk.lock();
+      head = (head + 1) % isize(slots);
+      qty--;
+      cv.notify_all();
+      }
+    }
+
+  void push(SDL_Surface *s) {
+    std::unique_lock<std::mutex> lk(lock);
+    if(qty == isize(slots)) {
+      auto t0 = std::chrono::steady_clock::now();
+      cv.wait(lk, [this] { return qty < isize(slots); });
+      encoder_stall_ms += std::chrono::duration<ld, std::milli>(std::chrono::steady_clock::now() - t0).count();
+      }
+    auto& slot = slots[(head + qty) % isize(slots)];
+    lk.unlock();
+    /* the writer does not touch this slot until qty is increased */
+    slot.resize(size_t(shotx) * shoty);
+    for(int y=0; y<shoty; y++) memcpy(&slot[size_t(y) * shotx], &qpixel(s, 0, y), 4 * shotx);
+    lk.lock();
+    qty++;
+    cv.notify_all();
+    }
+
+  void finish() {
+    if(!writer.joinable()) return;
+    { std::unique_lock<std::mutex> lk(lock); finishing = true; cv.notify_all(); }
+    writer.join();
+    slots.clear();
+    }
+
+  bool active() { return writer.joinable(); }
+  };
+
+frame_ring video_frames;
+#endif
+
+/** start writing raw frames to rawfile_handle */
+EX void start_raw_frames() {
+  frames_written = 0; encoder_stall_ms = 0;
+  #if CAP_THREAD
+  if(video_ring > 0) video_frames.start(video_ring);
+  #endif
+  }
+
+/** wait until all the raw frames have been written */
+EX void finish_raw_frames() {
+  #if CAP_THREAD
+  video_frames.finish();
+  #endif
+  }
+
 EX void output(SDL_Surface* s, const string& fname) {
   if(format == screenshot_format::rawfile) {
+    frames_written++;
+    #if CAP_THREAD
+    if(video_frames.active()) { video_frames.push(s); return; }
+    #endif
+    auto t0 = std::chrono::steady_clock::now();
     for(int y=0; y<shoty; y++)
       ignore(write(rawfile_handle, &qpixel(s, 0, y), 4 * shotx));
+    encoder_stall_ms += std::chrono::duration<ld, std::milli>(std::chrono::steady_clock::now() - t0).count();
     }
   else
     IMAGESAVE(s, fname.c_str());
@@ -942,6 +1036,256 @@ int png_read_args() {
 auto ah_png = addHook(hooks_args, 0, png_read_args);
 #endif
 
+#if CAP_COMMANDLINE
+#if HDR
+/** \brief one job of a batch of screenshots
+ *
+ *  Empty fields use the setting from the start of the batch (see shot_baseline). The view is given as in -sview.
+ */
+struct shot_job {
+  string geometry, variation, tessellation, model, view, output;
+  };
+
+/** \brief the settings in effect when the batch started
+ *
+ *  Every job restores the settings it does not give, so that the result does not
+ *  depend on which jobs were taken before it by the same worker.
+ */
+struct shot_baseline {
+  eGeometry geo;
+  eVariation var;
+  string tes;
+  eModel model;
+  transmatrix view, which_copy;
+  #if CAP_GP
+  gp::loc param;
+  #endif
+  };
+#endif
+
+/** \brief read the jobs for batch_take
+ *
+ *  One job per line, with tab-separated fields: geometry, variation, tessellation file,
+ *  model, view matrix, output path. A field equal to '-' (or missing) repeats the
+ *  previous job in the file; a field never given stays empty. Lines starting with '#'
+ *  are comments. The format is chosen by the extension of the output path.
+ */
+EX vector<shot_job> read_jobs(const string& fname) {
+  vector<shot_job> res;
+  fhstream f(fname, "rt");
+  if(!f.f) throw hr_exception("cannot open job file: " + fname);
+  /* resolved here, in the file order, since batch_take reorders the jobs */
+  vector<string> last(5);
+  while(!feof(f.f)) {
+    string s = scanline_noblank(f);
+    if(s == "" || s[0] == '#') continue;
+    auto v = split_string(s, '\t');
+    v.resize(6);
+    if(v[5] == "" || v[5] == "-") { println(hlog, "job without output ignored: ", s); continue; }
+    /* a geometry and a tessellation file exclude each other */
+    if(v[0] != "" && v[0] != "-") last[2] = "";
+    if(v[2] != "" && v[2] != "-") last[0] = "";
+    for(int i=0; i<5; i++) {
+      if(v[i] == "" || v[i] == "-") v[i] = last[i];
+      last[i] = v[i];
+      }
+    res.push_back(shot_job{v[0], v[1], v[2], v[3], v[4], v[5]});
+    }
+  return res;
+  }
+
+EX shot_baseline current_baseline() {
+  shot_baseline b;
+  b.geo = geometry; b.var = variation;
+  #if CAP_ARCM
+  if(geometry == gArbitrary) b.tes = arb::current.filename;
+  #endif
+  b.model = vpconf.model;
+  b.view = View; b.which_copy = current_display->which_copy;
+  #if CAP_GP
+  b.param = gp::param;
+  #endif
+  return b;
+  }
+
+/** the variation names accepted in jobs; Goldberg variations are given as "gp x y" */
+EX eVariation read_variation(const string& s) {
+  if(s == "pure") return eVariation::pure;
+  if(s == "bitruncated") return eVariation::bitruncated;
+  if(s == "dual") return eVariation::dual;
+  if(s == "untruncated") return eVariation::untruncated;
+  if(s == "unrectified") return eVariation::unrectified;
+  if(s == "warped") return eVariation::warped;
+  if(s.substr(0, 3) == "gp ") return eVariation::goldberg;
+  throw hr_exception("unknown variation: " + s);
+  }
+
+/** set up the game as requested by the job, and take the screenshot; the fields not given by the job are taken from b */
+EX void take_job(const shot_job& j, const shot_baseline& b) {
+  #if CAP_ARCM
+  if(j.tessellation != "" || (j.geometry == "" && b.geo == gArbitrary)) {
+    string tes = j.tessellation != "" ? j.tessellation : b.tes;
+    if(geometry != gArbitrary || arb::current.filename != tes) {
+      stop_game();
+      arb::run_raw(tes);
+      }
+    }
+  else
+  #endif
+  {
+    eGeometry g = j.geometry != "" ? readGeo(j.geometry) : b.geo;
+    if(geometry != g) set_geometry(g);
+    }
+  eVariation v = j.variation != "" ? read_variation(j.variation) : b.var;
+  #if CAP_GP
+  if(v == eVariation::goldberg) {
+    gp::loc param = b.param;
+    if(j.variation != "") {
+      int x = 1, y = 0;
+      sscanf(j.variation.c_str(), "gp %d %d", &x, &y);
+      param = gp::loc(x, y);
+      }
+    if(gp::param != param) stop_game();
+    gp::param = param;
+    }
+  #endif
+  set_variation(v);
+  start_game();
+  vpconf.model = j.model != "" ? models::read_model(j.model) : b.model;
+  View = b.view; current_display->which_copy = b.which_copy;
+  if(j.view != "") {
+    View = parsematrix(j.view);
+    current_display->which_copy = View * inverse(b.view) * b.which_copy;
+    }
+  playermoved = false;
+  string ext = j.output.size() >= 4 ? j.output.substr(j.output.size() - 4) : "";
+  dynamicval<screenshot_format> df(format, ext == ".svg" ? screenshot_format::svg : screenshot_format::png);
+  take(j.output);
+  }
+
+/** how many geometry_information objects batch_take keeps around */
+EX int batch_cgi_cache = 16;
+
+/** run jobs [from, to), one after another; returns the number of failures */
+int run_jobs(const vector<shot_job>& jobs, int from, int to, const shot_baseline& b) {
+  int failed = 0;
+  for(int i=from; i<to; i++) {
+    try {
+      take_job(jobs[i], b);
+      }
+    catch(hr_exception& e) {
+      println(hlog, "job ", i, " (", jobs[i].output, ") failed: ", e.what());
+      failed++;
+      }
+    }
+  return failed;
+  }
+
+/** \brief a batch prepared by prepare_batch, waiting for batch_take */
+struct batch_state {
+  vector<shot_job> jobs;
+  int workers;
+  /** the shares of jobs to run in this process */
+  vector<pair<int, int>> shares;
+  /** the worker processes forked by this process */
+  vector<int> pids;
+  /** is this a forked worker? */
+  bool child;
+  };
+
+batch_state *pending_batch;
+
+/** \brief read the job file, sort the jobs, and fork the workers
+ *
+ *  Jobs are sorted so that the ones sharing a geometry are consecutive, and each worker
+ *  takes a contiguous share, so that it reuses the geometry_information objects kept in
+ *  cgis. This is called before the graphics and audio are initialized, so that every
+ *  worker initializes its own. If a fork fails, its share is run by the parent.
+ */
+EX void prepare_batch(const string& fname, int workers IS(1)) {
+  auto& b = *(pending_batch = new batch_state);
+  b.jobs = read_jobs(fname);
+  stable_sort(b.jobs.begin(), b.jobs.end(), [] (const shot_job& a, const shot_job& b) {
+    return tie(a.tessellation, a.geometry, a.variation) < tie(b.tessellation, b.geometry, b.variation);
+    });
+  b.workers = workers; b.child = false;
+  int N = isize(b.jobs);
+  #if ISLINUX
+  if(workers > 1) {
+    fflush(stdout);
+    for(int w=1; w<workers; w++) {
+      int pid = fork();
+      if(pid == 0) {
+        b.child = true; b.pids.clear(); b.shares.clear();
+        b.shares.emplace_back(N * w / workers, N * (w+1) / workers);
+        return;
+        }
+      if(pid > 0) b.pids.push_back(pid);
+      else {
+        println(hlog, "fork failed, the share of worker ", w, " is taken by the main process");
+        b.shares.emplace_back(N * w / workers, N * (w+1) / workers);
+        }
+      }
+    }
+  #endif
+  b.shares.emplace_back(0, N / workers);
+  }
+
+/** \brief take all the screenshots listed in the job file (see read_jobs) */
+EX void batch_take(const string& fname, int workers IS(1)) {
+  if(!pending_batch) {
+    /* too late to fork safely */
+    if(workers > 1) println(hlog, "batch screenshots: workers can be only used from the command line");
+    prepare_batch(fname, 1);
+    }
+  auto& b = *pending_batch;
+  dynamicval<int> dc(cgi_cache_limit, max(cgi_cache_limit, batch_cgi_cache));
+  auto base = current_baseline();
+  auto start = std::chrono::steady_clock::now();
+  int failed = 0;
+  for(auto sh: b.shares) failed += run_jobs(b.jobs, sh.first, sh.second, base);
+  #if ISLINUX
+  if(b.child) {
+    fflush(stdout);
+    _exit(min(failed, 255));
+    }
+  for(int pid: b.pids) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if(WIFEXITED(status)) failed += WEXITSTATUS(status);
+    else failed++;
+    }
+  #endif
+  ld secs = std::chrono::duration<ld>(std::chrono::steady_clock::now() - start).count();
+  int qty = isize(b.jobs);
+  println(hlog, "batch screenshots: ", qty - failed, " of ", qty, " jobs done in ", fts(secs), " s = ", fts(qty / max<ld>(secs, 1e-6)), " jobs/s, ", b.workers, " worker(s)", failed ? ", " + its(failed) + " failed" : "");
+  delete pending_batch; pending_batch = nullptr;
+  }
+
+int batch_read_args() {
+  using namespace arg;
+  if(argis("-shot-batch")) {
+    PHASEFROM(2);
+    /* the workers are forked before the graphics are initialized; the screenshots are taken in phase 3 */
+    if(curphase == 2) {
+      if(!pending_batch) { shift(); string fname = args(); shift(); prepare_batch(fname, max(argi(), 1)); unshift(); unshift(); }
+      return 2;
+      }
+    shift(); start_game();
+    string fname = args();
+    shift(); int workers = max(argi(), 1);
+    batch_take(fname, workers);
+    }
+  else if(argis("-shot-batch-cache")) {
+    shift(); batch_cgi_cache = argi();
+    }
+  else return 1;
+  return 0;
+  }
+
+auto ah_batch = addHook(hooks_args, 0, batch_read_args);
+#endif
+
 EX string format_name() {
   if(format == screenshot_format::svg) return "SVG";
   if(format == screenshot_format::wrl) return "WRL";
@@ -1558,13 +1902,136 @@ EX bool record_video(string fname IS(videofile), bool_reaction_t rec IS(record_a
   close(tab[0]);
   shot::rawfile_handle = tab[1];
   dynamicval<shot::screenshot_format> sf(shot::format, shot::screenshot_format::rawfile);
+  auto start = std::chrono::steady_clock::now();
+  #if CAP_PNG
+  shot::start_raw_frames();
+  #endif
   rec();
+  #if CAP_PNG
+  shot::finish_raw_frames();
+  #endif
   close(tab[1]);
   wait(nullptr);
+  #if CAP_PNG
+  ld secs = std::chrono::duration<ld>(std::chrono::steady_clock::now() - start).count();
+  println(hlog, "recorded ", shot::frames_written, " frames to ", fname, " in ", fts(secs), " s = ", fts(shot::frames_written / max<ld>(secs, 1e-6)), " frames/s, encoder stall ", fts(shot::encoder_stall_ms / 1000), " s");
+  #endif
   callhooks(hooks_after_video);
   return true;
   }
 
+/** \brief number of processes used to record a video; see record_video_sharded */
+EX int video_shards = 1;
+
+/** \brief a sharded recording prepared by prepare_video_shards, waiting for record_video_sharded */
+struct video_shards_state {
+  /** the frame ranges and the part files of all the shards */
+  vector<pair<int, int>> ranges;
+  vector<string> parts;
+  /** the shards to record in this process */
+  vector<int> mine;
+  /** the shard processes forked by this process */
+  vector<int> pids;
+  /** is this a forked shard? */
+  bool child;
+  };
+
+video_shards_state *pending_shards;
+
+/** \brief split the frames min_frame..max_frame into shards, and fork the shard processes
+ *
+ *  This is called before the graphics are initialized (and before any worker threads exist),
+ *  so that every shard initializes its own; forking a process with a live GL context or
+ *  worker threads is not safe. If a fork fails, its shard is recorded by the parent.
+ */
+EX void prepare_video_shards(const string& fname, int shards, int frames) {
+  auto& s = *(pending_shards = new video_shards_state);
+  s.child = false;
+  int lo = min_frame, hi = min(max_frame, frames-1);
+  size_t dot = fname.rfind('.');
+  string base = dot == string::npos ? fname : fname.substr(0, dot);
+  string ext = dot == string::npos ? "" : fname.substr(dot);
+  for(int k=0; k<shards; k++) {
+    s.parts.push_back(base + "-part" + its(k) + ext);
+    s.ranges.emplace_back(lo + (hi-lo+1) * k / shards, lo + (hi-lo+1) * (k+1) / shards - 1);
+    }
+  fflush(stdout);
+  for(int k=1; k<shards; k++) {
+    int pid = fork();
+    if(pid == 0) {
+      s.child = true; s.pids.clear(); s.mine = {k};
+      return;
+      }
+    if(pid > 0) s.pids.push_back(pid);
+    else {
+      println(hlog, "fork failed, shard ", k, " is recorded by the main process");
+      s.mine.push_back(k);
+      }
+    }
+  s.mine.insert(s.mine.begin(), 0);
+  }
+
+/** \brief record the video in several processes, and concatenate the parts
+ *
+ *  Each process renders a contiguous range of the frames min_frame..max_frame into its
+ *  own file, and the parts are joined by ffmpeg without reencoding. The processes are
+ *  forked by prepare_video_shards, before the graphics are initialized, so sharding is
+ *  only available from the command line (-animvideo-shards); otherwise the video is
+ *  recorded serially.
+ */
+EX bool record_video_sharded(string fname IS(videofile), int shards IS(video_shards), bool_reaction_t rec IS(record_animation)) {
+  if(!pending_shards) {
+    /* too late to fork safely */
+    if(shards > 1) println(hlog, "video shards: too late to fork safely (they can be only used from the command line), recording serially");
+    return record_video(fname, rec);
+    }
+  auto& s = *pending_shards;
+  auto start = std::chrono::steady_clock::now();
+  bool all_ok = true;
+  for(int k: s.mine) {
+    dynamicval<int> d1(min_frame, s.ranges[k].first), d2(max_frame, s.ranges[k].second);
+    if(!record_video(s.parts[k], rec)) all_ok = false;
+    }
+  if(s.child) {
+    fflush(stdout);
+    _exit(all_ok ? 0 : 1);
+    }
+  for(int pid: s.pids) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if(!WIFEXITED(status) || WEXITSTATUS(status)) all_ok = false;
+    }
+  auto parts = s.parts;
+  int qty = max(s.ranges.back().second - s.ranges[0].first + 1, 0);
+  shards = isize(parts);
+  delete pending_shards; pending_shards = nullptr;
+
+  if(!all_ok) {
+    /* some shards are missing, so the parts cannot be joined */
+    for(auto& p: parts) remove(p.c_str());
+    addMessage("Error: a video shard failed");
+    return false;
+    }
+
+  size_t dot = fname.rfind('.');
+  string base = dot == string::npos ? fname : fname.substr(0, dot);
+  string listname = base + "-parts.txt";
+  FILE *f = fopen(listname.c_str(), "wt");
+  if(!f) return false;
+  for(auto& p: parts) fprintf(f, "file '%s'\n", p.c_str());
+  fclose(f);
+  string cmd = "ffmpeg -hide_banner -loglevel error -y -f concat -safe 0 -i \"" + listname + "\" -c copy \"" + fname + "\"";
+  bool ok = system(cmd.c_str()) == 0;
+  if(ok) {
+    for(auto& p: parts) remove(p.c_str());
+    remove(listname.c_str());
+    }
+  ld secs = std::chrono::duration<ld>(std::chrono::steady_clock::now() - start).count();
+  println(hlog, "recorded ", qty, " frames to ", fname, " on ", shards, " processes in ", fts(secs), " s = ", fts(qty / max<ld>(secs, 1e-6)), " frames/s");
+  callhooks(hooks_after_video);
+  return ok;
+  }
+
 EX bool record_video_std() {
   return record_video(videofile, record_animation);
   }
@@ -1830,9 +2297,29 @@ int readArgs() {
 #endif
 #if CAP_VIDEO
   else if(argis("-animvideo")) {
+    PHASEFROM(2);
+    /* the shards are forked before the graphics are initialized; the video is recorded in phase 3 */
+    if(curphase == 2) {
+      bool threads_live = false;
+      #if CAP_THREAD
+      threads_live = !workers.workers.empty();
+      #endif
+      if(!pending_shards && video_shards > 1 && !threads_live) {
+        shift(); int n = argi(); shift(); prepare_video_shards(args(), video_shards, n ? n : noframes); unshift(); unshift();
+        }
+      return 2;
+      }
     start_game();
-    PHASE(3); shift(); noframes = argi() ? argi() : noframes;
-    shift(); videofile = args(); record_video();
+    shift(); noframes = argi() ? argi() : noframes;
+    shift(); videofile = args(); record_video_sharded();
+    }
+  else if(argis("-animvideo-shards")) {
+    shift(); video_shards = argi();
+    }
+#endif
+#if CAP_PNG
+  else if(argis("-video-ring")) {
+    shift(); shot::video_ring = argi();
     }
 #endif
 #endif
@@ -1848,6 +2335,9 @@ auto animhook = addHook(hooks_frame, 100, display_animation)
   + addHook(hooks_configfile, 100, [] {
     #if CAP_CONFIG
     param_i(anims::noframes, "animation frames");
+    #if CAP_PNG
+    param_i(shot::video_ring, "video_ring");
+    #endif
     param_f(anims::cycle_length, parameter_names("acycle", "animation cycle length"));
     param_f(anims::parabolic_length, parameter_names("aparabolic", "animation parabolic length"))
       ->editable(0, 10, 1, "cells to go", "", 'c');
@@ -67,6 +67,9 @@ struct monster : cell_content, dim_listener {
   int split_owner;  ///< in splitscreen mode, which player handles this
   int split_tick;   ///< in which tick was split_owner computed
 
+  int nv_index;     ///< position in nonvirtual when the monster index was built
+  int index_stamp;  ///< used by the monster index to avoid reporting a monster twice
+
   void reset();
 
   monster *as_monster() override { return this; }
@@ -75,6 +78,7 @@ struct monster : cell_content, dim_listener {
   monster() {
     reset();
     split_tick = -1; split_owner = -1;
+    nv_index = 0; index_stamp = 0;
     no_targetting = false;
     dead = false; inBoat = false; parent = nullptr;
     }
@@ -125,12 +129,77 @@ EX cell_content_list active;
 
 EX vector<monster*> nonvirtual, additional;
 
+/** \brief spatial index of nonvirtual, by base cell
+ *
+ *  Built at the start of every tick. Monsters which change their base cell during the
+ *  tick are recorded in `moved`; once too many have accumulated, the index is rebuilt.
+ */
+struct monster_index_t {
+  bool built = false;
+  /** sorted by cell */
+  vector<pair<cell*, monster*>> entries;
+  vector<monster*> moved;
+  ld max_radius;
+  int stamp = 0;
+  epoch_set<cell*> near_cells;
+  vector<cell*> near_list;
+
+  void build();
+
+  void rebased(monster *m) {
+    if(!built) return;
+    moved.push_back(m);
+    if(isize(moved) > 64 + isize(entries) / 8) build();
+    }
+
+  void remove(monster *m) {
+    if(!built) return;
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [m] (const pair<cell*, monster*>& p) { return p.second == m; }), entries.end());
+    moved.erase(std::remove(moved.begin(), moved.end(), m), moved.end());
+    }
+
+  const vector<monster*>& near(cell *c, ld dist, vector<monster*>& buf);
+  };
+
+monster_index_t monster_index;
+
+/** sqdist(m->pat*C0, H) for all the given monsters, computed in one batch where possible */
+void sqdists(const vector<monster*>& v, const shiftpoint& H, vector<ld>& res) {
+  int N = isize(v);
+  res.resize(N);
+  bool same_shift = !gproduct;
+  for(monster *m: v) if(m->pat.shift != H.shift) same_shift = false;
+  if(!same_shift) {
+    for(int i=0; i<N; i++) res[i] = sqdist(v[i]->pat*C0, H);
+    return;
+    }
+  static vector<hyperpoint> pts;
+  pts.resize(N);
+  for(int i=0; i<N; i++) pts[i] = tC0(v[i]->pat.T);
+  intval_batch(H.h, pts.data(), res.data(), N);
+  }
+
+/** a distance d such that sqdist(a, b) < x implies that a and b are closer than d */
+ld sqdist_radius(ld x) {
+  if(gproduct || euclid) return sqrt(x);
+  if(hyperbolic) return acosh(1 + x / 2);
+  return x < 4 ? acos(1 - x / 2) : M_PI;
+  }
+
+/** sqdist between two points in distance d */
+ld sqdist_at(ld d) {
+  if(gproduct || euclid) return d * d;
+  if(hyperbolic) return 2 * cosh(d) - 2;
+  return d < M_PI ? 2 - 2 * cos(d) : 4;
+  }
+
 monster::~monster() {
   if(mousetarget == this) mousetarget = nullptr;
   if(lmousetarget == this) lmousetarget = nullptr;
   callhooks(hooks_destroy_monster, this);
   if(parent) parent->unref();
   nonvirtual.erase(std::remove(nonvirtual.begin(), nonvirtual.end(), this), nonvirtual.end());
+  monster_index.remove(this);
   }
 
 cell *findbaseAround(shiftpoint p, cell *around, int maxsteps) {
@@ -188,6 +257,7 @@ cell *monster::findbase(const shiftmatrix& T, int maxsteps) {
   }
 
 void monster::rebasePat(const shiftmatrix& new_pat, cell *c2) {
+  if(base != c2) monster_index.rebased(this);
   if(isVirtual) {
     at = new_pat.T;
     virtualRebase(this);
@@ -279,6 +349,61 @@ ld collision_distance(monster *bullet, monster *target) {
   return collision_radius(bullet) + collision_radius(target);
   }
 
+void monster_index_t::build() {
+  entries.clear(); moved.clear();
+  max_radius = 0;
+  for(int i=0; i<isize(nonvirtual); i++) {
+    monster *m = nonvirtual[i];
+    m->nv_index = i;
+    entries.emplace_back(m->base, m);
+    max_radius = max(max_radius, collision_radius(m));
+    }
+  sort(entries.begin(), entries.end());
+  built = true;
+  }
+
+/** \brief nonvirtual monsters which may be within distance dist from a point in cell c, in the nonvirtual order
+ *
+ *  Monsters in cells which are too far in the cell graph are skipped. The result is stored in buf;
+ *  if dist is large relative to the cells, nonvirtual itself is returned instead.
+ */
+const vector<monster*>& monster_index_t::near(cell *c, ld dist, vector<monster*>& buf) {
+  int radius = 99;
+  if(built && WDIM == 2 && cgi.crossf > 1e-3)
+    radius = 2 + int(dist / cgi.crossf) + (valence() > 4 ? 1 : 0);
+  if(radius > 4) return nonvirtual;
+
+  near_cells.clear(); near_list.clear();
+  near_cells.insert(c); near_list.push_back(c);
+  int layer_start = 0;
+  for(int r=0; r<radius; r++) {
+    int layer_end = isize(near_list);
+    for(int i=layer_start; i<layer_end; i++) {
+      cell *c1 = near_list[i];
+      for(int j=0; j<c1->type; j++) {
+        cell *c2 = c1->move(j);
+        if(c2 && near_cells.insert(c2)) near_list.push_back(c2);
+        }
+      }
+    layer_start = layer_end;
+    }
+
+  stamp++;
+  buf.clear();
+  auto consider = [&] (monster *m) {
+    if(m->index_stamp == stamp || !near_cells.count(m->base)) return;
+    m->index_stamp = stamp;
+    buf.push_back(m);
+    };
+  for(cell *c1: near_list) {
+    auto it = lower_bound(entries.begin(), entries.end(), make_pair(c1, (monster*) nullptr));
+    for(; it != entries.end() && it->first == c1; it++) consider(it->second);
+    }
+  for(monster *m: moved) consider(m);
+  sort(buf.begin(), buf.end(), [] (monster *m1, monster *m2) { return m1->nv_index < m2->nv_index; });
+  return buf;
+  }
+
 void killMonster(monster* m, eMonster who_kills, flagtype flags = 0) {
   int tk = tkills();
   if(callhandlers(false, hooks_kill, m)) return;
@@ -1120,8 +1245,13 @@ void movePlayer(monster *m, int delta) {
     
     if(!m->isVirtual) {
       crashintomon = playerCrash(m, nat*C0);
-      for(monster *m2: nonvirtual) if(m2!=m && m2->type == passive_switch) {
-        double d = sqdist(m2->pat*C0, nat*C0);
+      static vector<monster*> nearby_buf;
+      static vector<ld> dists;
+      auto& nearby = monster_index.near(c2, sqdist_radius(SCALE2 * 0.2), nearby_buf);
+      sqdists(nearby, nat*C0, dists);
+      for(int i=0; i<isize(nearby); i++) if(nearby[i]!=m && nearby[i]->type == passive_switch) {
+        monster *m2 = nearby[i];
+        double d = dists[i];
         if(collision_debug_level >= 2) collisions.emplace_back(collision_info{m->pat*C0, m2->pat*C0, 0x00FF00FF});
         if(d < SCALE2 * 0.2) crashintomon = m2;
         }
@@ -1353,10 +1483,15 @@ void movePlayer(monster *m, int delta) {
   if(items[itOrbHorns] && !m->isVirtual) {
     shiftpoint H = hornpos(cpid);
 
-    for(monster *m2: nonvirtual) {
+    static vector<monster*> nearby_buf;
+    static vector<ld> dists;
+    auto& nearby = monster_index.near(findbaseAround(H, m->base, 999), sqdist_radius(SCALE2 * 0.1), nearby_buf);
+    sqdists(nearby, H, dists);
+    for(int i=0; i<isize(nearby); i++) {
+      monster *m2 = nearby[i];
       if(m2 == m) continue;
       
-      double d = sqdist(m2->pat*C0, H);
+      double d = dists[i];
     
       if(d < SCALE2 * 0.1) {
         if(hornKills(m2->type))
@@ -1371,11 +1506,17 @@ void movePlayer(monster *m, int delta) {
   
     for(double d=0; d<=1.001; d += .1) {
       shiftpoint H = swordpos(cpid, b, d);
+      cell *c3 = findbaseAround(H, m->base, 999);
   
-      for(monster *m2: nonvirtual) {
+      static vector<monster*> nearby_buf;
+      static vector<ld> dists;
+      auto& nearby = monster_index.near(c3, sqdist_radius(SCALE2 * 0.1), nearby_buf);
+      sqdists(nearby, H, dists);
+      for(int i=0; i<isize(nearby); i++) {
+        monster *m2 = nearby[i];
         if(m2 == m) continue;
         
-        double d = sqdist(m2->pat*C0, H);
+        double d = dists[i];
       
         if(d < SCALE2 * 0.1) {
           if(swordKills(m2->type) && !(isBullet(m2) && m2->pid == cpid))
@@ -1383,7 +1524,6 @@ void movePlayer(monster *m, int delta) {
         }
       }
   
-      cell *c3 = findbaseAround(H, m->base, 999);
       if(c3->wall == waSmallTree || c3->wall == waBigTree || c3->wall == waBarrowDig || c3->wall == waCavewall ||
         (c3->wall == waBarrowWall && items[itBarrow] >= 25))
         c3->wall = waNone;
@@ -1603,11 +1743,22 @@ eItem targetRangedOrbKey(orbAction a) {
   mouseover = findbaseAround(mouseh, mouseover, 999);
   mousetarget = NULL;
 
-  for(monster *m2: nonvirtual) {
-    if(m2->dead) continue;
-    if(m2->no_targetting) continue;
-    if(!mousetarget || sqdist(mouseh, mousetarget->pat*C0) > sqdist(mouseh, m2->pat*C0)) 
-      mousetarget = m2;
+  /* the closest monster found near the mouse is the closest overall if it is within target_range */
+  ld target_range = SCALE * 2;
+  static vector<monster*> nearby_buf;
+  auto find_target = [] (const vector<monster*>& v) {
+    for(monster *m2: v) {
+      if(m2->dead) continue;
+      if(m2->no_targetting) continue;
+      if(!mousetarget || sqdist(mouseh, mousetarget->pat*C0) > sqdist(mouseh, m2->pat*C0)) 
+        mousetarget = m2;
+      }
+    };
+  auto& nearby = monster_index.near(mouseover, target_range, nearby_buf);
+  find_target(nearby);
+  if(&nearby != &nonvirtual && (!mousetarget || sqdist(mouseh, mousetarget->pat*C0) > sqdist_at(target_range))) {
+    mousetarget = NULL;
+    find_target(nonvirtual);
     }
 
   eItem r = targetRangedOrb(mouseover, a);
@@ -1832,7 +1983,8 @@ void moveBullet(monster *m, int delta) {
   
   bool no_self_hits = (m->type != moFlailBullet && !multi::self_hits) || m->fragoff > curtime;
 
-  if(!m->isVirtual) for(monster* m2: nonvirtual) {
+  static vector<monster*> nearby_buf;
+  if(!m->isVirtual) for(monster* m2: monster_index.near(m->base, collision_radius(m) + monster_index.max_radius, nearby_buf)) {
     if(m2 == m) continue;
     if((m2 == m->parent && no_self_hits) || (m2->parent == m->parent && no_self_hits)) continue;
     
@@ -2117,9 +2269,10 @@ void moveMonster(monster *m, int delta) {
   else {
   
     if(m->type == moSleepBull && !m->isVirtual) {
-      for(monster *m2: nonvirtual) if(m2!=m && m2->type != moBullet && m2->type != moArrowTrap) {
-        double d = sqdist(m2->pat*C0, nat*C0);
-        if(d < SCALE2*3 && m2->type == moPlayer) m->type = moRagingBull;
+      /* only players can awaken bulls */
+      for(int i=0; i<players; i++) if(pc[i] && pc[i] != m && !pc[i]->isVirtual) {
+        double d = sqdist(pc[i]->pat*C0, nat*C0);
+        if(d < SCALE2*3) m->type = moRagingBull;
         }
       }
     
@@ -2127,7 +2280,8 @@ void moveMonster(monster *m, int delta) {
       if(pc[pid]->isVirtual) continue;
       if(m->isVirtual) continue;
       bool okay = sqdist(pc[pid]->pat*C0, m->pat*C0) < 2 * SCALE2;
-      for(monster *m2: nonvirtual) {
+      static vector<monster*> nearby_buf;
+      for(monster *m2: monster_index.near(m->base, sqdist_radius(2 * SCALE2), nearby_buf)) {
         if(m2 != m && isWitch(m2->type) && sqdist(m2->pat*C0, m->pat*C0) < 2 * SCALE2)
           okay = false;
         }
@@ -2141,23 +2295,34 @@ void moveMonster(monster *m, int delta) {
         }
       }
     if(isBug(m->type)) {
-      vector<monster*> bugtargets;
-      for(monster *m2: nonvirtual) 
-        if(!isBullet(m2))
-        if(m2->type != m->type)
-        if(!isPlayer(m2) || !invismove)
-        if(!m2->dead)
-          bugtargets.push_back(m2);
-      
+      /* try the targets in the order of distance; those within bug_range are found with the index first */
+      static vector<monster*> bugtargets, nearby_buf;
+      ld bug_range = SCALE * 2;
       closerTo = m->pat * C0;
-      sort(bugtargets.begin(), bugtargets.end(), closer);
-  
-      if(step) for(monster *m2: bugtargets)
-        if(trackroute(m, m2->pat, step)) {
-          goal = m2->pat;
-          direct = true;
-          break;
+      auto try_targets = [&] (const vector<monster*>& v, ld limit) {
+        bugtargets.clear();
+        for(monster *m2: v) 
+          if(!isBullet(m2))
+          if(m2->type != m->type)
+          if(!isPlayer(m2) || !invismove)
+          if(!m2->dead)
+            bugtargets.push_back(m2);
+        sort(bugtargets.begin(), bugtargets.end(), closer);
+        for(monster *m2: bugtargets) {
+          if(sqdist(m2->pat*C0, closerTo) > limit) return false;
+          if(trackroute(m, m2->pat, step)) {
+            goal = m2->pat;
+            direct = true;
+            return true;
+            }
           }
+        return false;
+        };
+      if(step) {
+        auto& nearby = monster_index.near(m->base, bug_range, nearby_buf);
+        if(&nearby == &nonvirtual) try_targets(nonvirtual, HUGE_VAL);
+        else if(!try_targets(nearby, sqdist_at(bug_range))) try_targets(nonvirtual, HUGE_VAL);
+        }
       }
     else if(m->type == moWolf && !peace::on) {
       cell *cnext = c;
@@ -2306,9 +2471,15 @@ void moveMonster(monster *m, int delta) {
 
   monster* crashintomon = NULL;
   
-  if(!m->isVirtual && !inertia_based) for(monster *m2: nonvirtual) if(m2!=m && m2->type != moBullet && m2->type != moArrowTrap) {
-    double d = sqdist(m2->pat*C0, nat*C0);
-    if(d < SCALE2 * 0.1) crashintomon = m2;
+  if(!m->isVirtual && !inertia_based) {
+    static vector<monster*> nearby_buf;
+    static vector<ld> dists;
+    auto& nearby = monster_index.near(m->base, sqdist_radius(SCALE2 * 0.1) + abs(step), nearby_buf);
+    sqdists(nearby, nat*C0, dists);
+    for(int i=0; i<isize(nearby); i++) {
+      monster *m2 = nearby[i];
+      if(m2!=m && m2->type != moBullet && m2->type != moArrowTrap && dists[i] < SCALE2 * 0.1) crashintomon = m2;
+      }
     }
   
   if(inertia_based) for(int i=0; i<players; i++) {
@@ -2425,7 +2596,9 @@ void moveMonster(monster *m, int delta) {
       cell *c3 = m->base->move(i);
       if(neighborId(c3, c2) != -1 && c3->wall == waFreshGrave && gmatrix.count(c3)) {
         bool monstersNear = false;
-        for(monster *m2: nonvirtual) {
+        static vector<monster*> nearby_buf;
+        for(cell *c4: {c3, c2})
+        for(monster *m2: monster_index.near(c4, sqdist_radius(SCALE2 * .3), nearby_buf)) {
           if(m2 != m && sqdist(m2->pat*C0, gmatrix[c3]*C0) < SCALE2 * .3)
             monstersNear = true;
           if(m2 != m && sqdist(m2->pat*C0, gmatrix[c2]*C0) < SCALE2 * .3)
@@ -2488,6 +2661,7 @@ void moveMonster(monster *m, int delta) {
       }
     if(c2->wall == waBoat && !m->inBoat) {
       m->inBoat = true; c2->wall = waSea;
+      if(m->base != c2) monster_index.rebased(m);
       m->base = c2;
       }
     }
@@ -2686,6 +2860,7 @@ EX void turn(int delta) {
     else nonvirtual.push_back(m);
     exists[movegroup(m->type)] = true;
     }
+  monster_index.build();
   
   FOR_MONSTERS_IN_LIST(it, m, active) {
     
@@ -2867,6 +3042,7 @@ EX void turn(int delta) {
   
   for(monster *m: additional) m->add_to_list(active);
   additional.clear();
+  monster_index.built = false;
   
   if(delayed_safety) { 
     activateSafety(delayed_safety_land);
@@ -2994,6 +3170,51 @@ EX void addShmupHelp(string& out) {
     }
   }
 
+/** \brief spawn qty Goblins around the player, run the given number of ticks, and report the speed */
+EX void benchmark(int qty, int ticks, int delta IS(20)) {
+  if(!on) { println(hlog, "the shmup benchmark requires the shoot'em up mode"); return; }
+  celllister cl(cwt.at, 7, 1000000, nullptr);
+  vector<cell*> spots;
+  for(cell *c: cl.lst) if(c != cwt.at && passable(c, nullptr, 0)) spots.push_back(c);
+  if(spots.empty()) { println(hlog, "no room for monsters"); return; }
+  for(int i=0; i<qty; i++) {
+    monster *m = new monster;
+    m->base = spots[i % isize(spots)];
+    m->at = random_spin() * xpush(cgi.hcrossf * hrand(1000) / 4000.);
+    m->type = moGoblin;
+    m->store();
+    }
+  dynamicval<flagtype> dc(cmode, sm::NORMAL);
+  auto start = std::chrono::steady_clock::now();
+  for(int t=0; t<ticks; t++) {
+    make_actual_view();
+    just_gmatrix = true;
+    currentmap->draw_all();
+    just_gmatrix = false;
+    turn(delta);
+    }
+  ld secs = std::chrono::duration<ld>(std::chrono::steady_clock::now() - start).count();
+  println(hlog, "shmup benchmark: ", qty, " monsters, ", ticks, " ticks in ", fts(secs), " s = ", fts(ticks / secs), " ticks/s, ", isize(nonvirtual), " monsters active at the end");
+  }
+
+#if CAP_COMMANDLINE
+int read_args() {
+  using namespace arg;
+  if(0) ;
+  else if(argis("-shmup-bench")) {
+    PHASEFROM(3);
+    start_game();
+    shift(); int qty = argi();
+    shift(); int ticks = argi();
+    benchmark(qty, ticks);
+    }
+  else return 1;
+  return 0;
+  }
+
+auto ah = addHook(hooks_args, 100, read_args);
+#endif
+
 auto hooks = addHook(hooks_clearmemory, 0, shmup::clearMemory) +
   addHook(hooks_gamedata, 0, shmup::gamedata);
 
@@ -117,6 +117,18 @@
 #define CAP_FILES (!ISMINI)
 #endif
 
+#ifndef CAP_SIMD
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && defined(__GNUC__) && !ISWEB && !ISMOBILE
+#define CAP_SIMD 1
+#else
+#define CAP_SIMD 0
+#endif
+#endif
+
+#ifndef CAP_MMAP
+#define CAP_MMAP (CAP_FILES && !ISWINDOWS && !ISWEB && !ISMOBILE)
+#endif
+
 #ifndef CAP_INV
 #define CAP_INV (!ISMINI)
 #endif
@@ -627,6 +639,7 @@ typedef unsigned GLuint;
 #include <complex>
 #include <new>
 #include <limits.h>
+#include <chrono>
 
 #if CAP_VR
 #ifdef __MINGW32__
@@ -636,7 +649,7 @@ typedef unsigned GLuint;
 #endif
 #endif
 
-#if CAP_VIDEO
+#if CAP_VIDEO || ISLINUX
 #include <sys/wait.h>
 #endif
 
@@ -688,6 +701,15 @@ typedef unsigned GLuint;
 #include <sys/stat.h>
 #endif
 
+#if CAP_SIMD
+#include <immintrin.h>
+#endif
+
+#if CAP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
 #if CAP_TIMEOFDAY
 #include <sys/time.h>
 #endif
@@ -993,43 +993,153 @@ EX void replace_str(string& s, string a, string b) {
 #if CAP_ZLIB
 /* compression/decompression */
 
-EX string compress_string(string s) {
+#if HDR
+/** \brief an hstream which compresses everything written to it into target, using a fixed amount of memory */
+struct zlib_output_hstream : hstream {
+  hstream& target;
+  z_stream strm;
+  vector<char> in, out;
+  size_t in_used;
+  bool finished;
+  /** gzip selects the gzip format instead of zlib */
+  explicit zlib_output_hstream(hstream& target, int level = 9, bool gzip = false);
+  ~zlib_output_hstream();
+  void write_char(char c) override { if(in_used == in.size()) deflate_buffer(Z_NO_FLUSH); in[in_used++] = c; }
+  void write_chars(const char* c, size_t q) override;
+  char read_char() override { throw hstream_exception("zlib_output_hstream is not readable"); }
+  void deflate_buffer(int mode);
+  /** \brief write the remaining data and end the compressed stream; the destructor calls this too, but ignores errors */
+  void finish();
+  };
+
+/** \brief an hstream which decompresses (zlib or gzip) data read from source, using a fixed amount of memory */
+struct zlib_input_hstream : hstream {
+  hstream& source;
   z_stream strm;
+  vector<char> in, out;
+  size_t out_pos, out_end;
+  bool at_end;
+  explicit zlib_input_hstream(hstream& source);
+  ~zlib_input_hstream() { inflateEnd(&strm); }
+  void write_char(char c) override { throw hstream_exception("zlib_input_hstream is not writable"); }
+  char read_char() override { if(out_pos == out_end) refill(); return out[out_pos++]; }
+  void read_chars(char* c, size_t q) override { if(read_some(c, q) != q) throw hstream_exception(); }
+  size_t read_some(char* c, size_t q) override;
+  /** \brief decompress the next part of the data; returns false at the end of the stream */
+  bool refill_some();
+  void refill() { while(out_pos == out_end) if(!refill_some()) throw hstream_exception(); }
+  };
+#endif
+
+EX int zlib_buffer_size = 1<<16;
+
+zlib_output_hstream::zlib_output_hstream(hstream& target, int level, bool gzip) : target(target) {
   strm.zalloc = Z_NULL;
   strm.zfree = Z_NULL;
   strm.opaque = Z_NULL;
-  println(hlog, "pre init");
-  auto ret = deflateInit(&strm, 9);
-  if(ret != Z_OK) throw hr_exception("z-error");
-  println(hlog, "init ok");
-  strm.avail_in = isize(s);
-  strm.next_in = (Bytef*) &s[0];
-  vector<char> buf(10000000, 0);
-  strm.avail_out = 10000000;
-  strm.next_out = (Bytef*) &buf[0];
-  if(deflate(&strm, Z_FINISH) != Z_STREAM_END) throw hr_exception("z-error-2");
-  println(hlog, "deflate ok");
-  string out(&buf[0], (char*)(strm.next_out) - &buf[0]);
+  if(deflateInit2(&strm, level, Z_DEFLATED, gzip ? 15+16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK) throw hr_exception("z-error");
+  in.resize(zlib_buffer_size); out.resize(zlib_buffer_size);
+  in_used = 0; finished = false;
+  }
+
+void zlib_output_hstream::deflate_buffer(int mode) {
+  strm.avail_in = in_used;
+  strm.next_in = (Bytef*) in.data();
+  while(true) {
+    strm.avail_out = isize(out);
+    strm.next_out = (Bytef*) out.data();
+    int ret = deflate(&strm, mode);
+    if(ret == Z_STREAM_ERROR) throw hstream_exception("z-error-2");
+    size_t have = isize(out) - strm.avail_out;
+    if(have) target.write_chars(out.data(), have);
+    if(mode == Z_FINISH ? ret == Z_STREAM_END : strm.avail_out != 0) break;
+    }
+  in_used = 0;
+  }
+
+void zlib_output_hstream::write_chars(const char* c, size_t q) {
+  while(q) {
+    if(in_used == in.size()) deflate_buffer(Z_NO_FLUSH);
+    size_t part = min(q, in.size() - in_used);
+    memcpy(&in[in_used], c, part);
+    in_used += part; c += part; q -= part;
+    }
+  }
+
+void zlib_output_hstream::finish() {
+  if(finished) return;
+  finished = true;
+  deflate_buffer(Z_FINISH);
   deflateEnd(&strm);
-  println(hlog, isize(s), " -> ", isize(out));
-  return out;
+  target.flush();
   }
 
-EX string decompress_string(string s) {
-  z_stream strm;
+zlib_output_hstream::~zlib_output_hstream() {
+  try { finish(); }
+  catch(hstream_exception&) { deflateEnd(&strm); }
+  }
+
+zlib_input_hstream::zlib_input_hstream(hstream& source) : source(source) {
   strm.zalloc = Z_NULL;
   strm.zfree = Z_NULL;
   strm.opaque = Z_NULL;
-  auto ret = inflateInit(&strm);
-  if(ret != Z_OK) throw hr_exception("z-error");
-  strm.avail_in = isize(s);
-  strm.next_in = (Bytef*) &s[0];
-  vector<char> buf(10000000, 0);
-  strm.avail_out = 10000000;
-  strm.next_out = (Bytef*) &buf[0];
-  if(inflate(&strm, Z_FINISH) != Z_STREAM_END) throw hr_exception("z-error-2");  
-  string out(&buf[0], (char*)(strm.next_out) - &buf[0]);
-  inflateEnd(&strm);
+  strm.avail_in = 0;
+  strm.next_in = Z_NULL;
+  /* 15+32 accepts both the zlib and the gzip headers */
+  if(inflateInit2(&strm, 15+32) != Z_OK) throw hr_exception("z-error");
+  in.resize(zlib_buffer_size); out.resize(zlib_buffer_size);
+  out_pos = out_end = 0; at_end = false;
+  }
+
+bool zlib_input_hstream::refill_some() {
+  if(at_end) return false;
+  if(strm.avail_in == 0) {
+    strm.avail_in = source.read_some(in.data(), in.size());
+    strm.next_in = (Bytef*) in.data();
+    }
+  bool source_empty = strm.avail_in == 0;
+  strm.avail_out = isize(out);
+  strm.next_out = (Bytef*) out.data();
+  int ret = inflate(&strm, Z_NO_FLUSH);
+  if(ret == Z_STREAM_END) at_end = true;
+  else if(ret != Z_OK && ret != Z_BUF_ERROR) throw hstream_exception("z-error-2");
+  out_pos = 0; out_end = isize(out) - strm.avail_out;
+  if(!out_end && !at_end && source_empty) throw hstream_exception("unexpected end of compressed data");
+  return out_end || !at_end;
+  }
+
+size_t zlib_input_hstream::read_some(char* c, size_t q) {
+  size_t total = 0;
+  while(q) {
+    if(out_pos == out_end && !refill_some()) break;
+    size_t part = min(q, out_end - out_pos);
+    memcpy(c, &out[out_pos], part);
+    out_pos += part; c += part; q -= part; total += part;
+    }
+  return total;
+  }
+
+/** \brief does the file start with the gzip magic number; the file position is reset to the start */
+EX bool is_gzip_file(FILE *f) {
+  int a = getc(f), b = getc(f);
+  rewind(f);
+  return a == 0x1f && b == 0x8b;
+  }
+
+EX string compress_string(string s) {
+  shstream out;
+  zlib_output_hstream z(out);
+  z.write_chars(s.data(), s.size());
+  z.finish();
+  println(hlog, isize(s), " -> ", isize(out.s));
+  return out.s;
+  }
+
+EX string decompress_string(string s) {
+  shstream in(s);
+  zlib_input_hstream z(in);
+  string out;
+  while(z.refill_some()) out.append(&z.out[0], z.out_end);
   println(hlog, isize(s), " -> ", isize(out));
   return out;
   }
@@ -1039,6 +1149,17 @@ EX bool file_exists(string fname) {
   return access(fname.c_str(), F_OK) != -1;
   }
 
+/** the directory for cached data which can be recomputed if lost; it is created if it does not exist, "" if not available */
+EX string user_cache_dir() {
+  string dir;
+  const char *res = getenv("XDG_CACHE_HOME");
+  if(res) dir = string(res) + "/hyperrogue";
+  else if((res = getenv("HOME"))) dir = string(res) + "/.cache/hyperrogue";
+  else return "";
+  if(!file_exists(dir)) hr::ignore(system(("mkdir -p \"" + dir + "\"").c_str()));
+  return dir;
+  }
+
 /** find a file named s, possibly in HYPERPATH */
 EX string find_file(string s) {
   string s1;
@@ -1170,4 +1291,134 @@ EX void floyd_warshall(vector<vector<char>>& v) {
   for(int j=0; j<N; j++)
     v[i][j] = min<int>(v[i][j], v[i][k] + v[k][j]);
   }
+
+/** \brief number of threads used by parallel_for (including the calling thread) */
+EX int worker_threads = 1;
+
+#if CAP_THREAD
+/** the thread which runs the game (static initializers run on it) */
+std::thread::id main_thread_id = std::this_thread::get_id();
+#endif
+
+/** \brief are we on the main thread? Lazily built caches which are not thread-safe should only be touched there */
+EX bool on_main_thread() {
+  #if CAP_THREAD
+  return std::this_thread::get_id() == main_thread_id;
+  #else
+  return true;
+  #endif
+  }
+
+#if HDR
+/** \brief a persistent set of worker threads for parallel_for
+ *
+ *  This is a general utility for read-only computations; the frame build (drawthemap) is serial.
+ */
+struct worker_pool {
+  #if CAP_THREAD
+  vector<std::thread> workers;
+  std::mutex lock;
+  std::condition_variable wake, finished;
+  const std::function<void(int, int)> *job = nullptr;
+  std::atomic<int> next_index;
+  int total = 0, chunk = 1, generation = 0, done = 0;
+  std::atomic<bool> running{false};
+  bool quitting = false;
+  /** the first exception thrown by the job; the remaining chunks are skipped, and run() rethrows it */
+  std::exception_ptr error;
+
+  void run_chunks() {
+    try {
+      while(true) {
+        int a = next_index.fetch_add(chunk);
+        if(a >= total) return;
+        (*job)(a, min(a + chunk, total));
+        }
+      }
+    catch(...) {
+      std::unique_lock<std::mutex> lk(lock);
+      if(!error) error = std::current_exception();
+      next_index = total;
+      }
+    }
+
+  void worker_loop(int seen) {
+    std::unique_lock<std::mutex> lk(lock);
+    while(true) {
+      wake.wait(lk, [&] { return quitting || generation != seen; });
+      if(quitting) return;
+      seen = generation;
+      lk.unlock();
+      run_chunks();
+      lk.lock();
+      done++;
+      finished.notify_all();
+      }
+    }
+
+  void stop() {
+    { std::unique_lock<std::mutex> lk(lock); quitting = true; }
+    wake.notify_all();
+    for(auto& t: workers) t.join();
+    workers.clear();
+    quitting = false;
+    }
+
+  void resize(int qty) {
+    stop();
+    for(int i=0; i<qty; i++) workers.emplace_back([this, g = generation] { worker_loop(g); });
+    }
+
+  /** \brief call action(a, b) for disjoint ranges covering [0, N); the calling thread helps too */
+  void run(int N, int min_chunk, const std::function<void(int, int)>& action) {
+    {
+      std::unique_lock<std::mutex> lk(lock);
+      job = &action; total = N; done = 0;
+      chunk = max(min_chunk, N / (8 * (isize(workers) + 1)) + 1);
+      next_index = 0;
+      generation++;
+      }
+    wake.notify_all();
+    run_chunks();
+    std::unique_lock<std::mutex> lk(lock);
+    finished.wait(lk, [&] { return done == isize(workers); });
+    job = nullptr;
+    if(error) {
+      auto e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+      }
+    }
+
+  ~worker_pool() { stop(); }
+  #endif
+  };
+#endif
+
+EX worker_pool workers;
+
+/** \brief run action(a, b) on subranges of [0, N), on worker_threads threads
+ *
+ *  Ranges are handed out dynamically, in chunks of at least min_chunk. The action must
+ *  not modify any shared state (including the game map or the draw queue). Nested calls,
+ *  and calls when worker_threads is 1, simply run action(0, N) on the calling thread.
+ */
+EX void parallel_for(int N, const std::function<void(int, int)>& action, int min_chunk IS(64)) {
+  #if CAP_THREAD
+  /* only one caller may use the pool at a time; others (including nested calls) run serially */
+  if(worker_threads > 1 && N > min_chunk && !workers.running.exchange(true)) {
+    try {
+      if(isize(workers.workers) != worker_threads - 1) workers.resize(worker_threads - 1);
+      workers.run(N, min_chunk, action);
+      }
+    catch(...) {
+      workers.running = false;
+      throw;
+      }
+    workers.running = false;
+    return;
+    }
+  #endif
+  if(N > 0) action(0, N);
+  }
 }